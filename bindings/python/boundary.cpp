@@ -1,56 +1,47 @@
-#include <boost/range/adaptors.hpp>
-namespace ba = boost::adaptors;
-
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 namespace py = pybind11;
 
+#include <dionysus/boundary-matrix.h>
+
 #include "filtration.h"
 #include "persistence.h"
 
 template<class PyFiltration>
-PyMatrixFiltration boundary(const PyFiltration& f)
+PyMatrixFiltration boundary(const PyFiltration& f, unsigned threads)
 {
     short prime = 3;
     PyReducedMatrix m(prime);
-    Dimensions dimensions;
     Values values;
     m.resize(f.size());
-    dimensions.resize(f.size());
     values.resize(f.size());
 
-    using Cell = typename PyFiltration::Cell;
-    using CellChainEntry = dionysus::ChainEntry<PyReducedMatrix::Field, Cell>;
     using Entry = PyReducedMatrix::Entry;
+    using Index = PyReducedMatrix::Index;
 
-    PyReducedMatrix::Index i = 0;
-    for(auto& c : f)
+    dionysus::BoundaryMatrix<Index> bm(f, threads);
+    const auto& offsets = bm.offsets();
+
+    for (Index i = 0; i < bm.size(); ++i)
     {
-        dimensions[i] = c.dimension();
-        values[i] = c.data();
-        m.set(i, c.boundary(m.field()) | ba::transformed([&f,prime,i](const CellChainEntry& e)
-                                         {
-                                           short ee = e.element();
-                                           if (ee > prime / 2)
-                                              ee -= prime;
-                                           return Entry(ee, f.index(e.index(),i));
-                                         }));
-        ++i;
+        values[i] = f[i].data();
+        PyReducedMatrix::Chain chain;
+        for (size_t k = offsets[i]; k < offsets[i+1]; ++k)
+            chain.emplace_back(Entry { bm.coefficients()[k], bm.indices()[k] });
+        m.set(i, std::move(chain));
     }
 
-    return PyMatrixFiltration(std::move(m),dimensions,values);
+    return PyMatrixFiltration(std::move(m),bm.dimensions(),values);
 }
 
 template<class PyFiltration>
-PyMatrixFiltration coboundary(const PyFiltration& f)
+PyMatrixFiltration coboundary(const PyFiltration& f, unsigned threads)
 {
     short prime = 3;
     PyReducedMatrix m(prime);
     Dimensions dimensions;
     Values values;
 
-    using Cell = typename PyFiltration::Cell;
-    using CellChainEntry = dionysus::ChainEntry<PyReducedMatrix::Field, Cell>;
     using Entry = PyReducedMatrix::Entry;
     using Index = PyReducedMatrix::Index;
 
@@ -59,23 +50,15 @@ PyMatrixFiltration coboundary(const PyFiltration& f)
     dimensions.resize(n);
     values.resize(n);
 
-    Index i = 0;
-    for(auto& c : f)
+    dionysus::BoundaryMatrix<Index> bm(f, threads);
+    const auto& offsets = bm.offsets();
+
+    for (Index i = 0; i < n; ++i)
     {
-        dimensions[n - 1 - i] = c.dimension();
-        values[n - 1 - i] = c.data();
-        for (auto x : c.boundary(m.field()) |
-                        ba::transformed([&f,prime,i](const CellChainEntry& e)
-                        {
-                          short ee = e.element();
-                          if (ee > prime / 2)
-                             ee -= prime;
-                          return Entry(ee, f.index(e.index(),i));
-                        }))
-        {
-            m.column(n - 1 - x.index()).emplace_back(Entry { x.element(), n - 1 - i });
-        }
-        ++i;
+        dimensions[n - 1 - i] = bm.dimensions()[i];
+        values[n - 1 - i] = f[i].data();
+        for (size_t k = offsets[i]; k < offsets[i+1]; ++k)
+            m.column(n - 1 - bm.indices()[k]).emplace_back(Entry { bm.coefficients()[k], n - 1 - i });
     }
 
     for (PyReducedMatrix::Index i = 0; i < m.size(); ++i)
@@ -87,8 +70,9 @@ PyMatrixFiltration coboundary(const PyFiltration& f)
 
 void init_boundary(py::module& m)
 {
-    m.def("boundary", &boundary<PyFiltration>, "compute boundary matrix of the filtration");
-    m.def("coboundary", &coboundary<PyFiltration>, "compute coboundary matrix of the filtration");
-    m.def("boundary", &boundary<PyMultiFiltration>, "compute boundary matrix of the filtration");
-    m.def("coboundary", &coboundary<PyMultiFiltration>, "compute coboundary matrix of the filtration");
+    using namespace pybind11::literals;
+    m.def("boundary", &boundary<PyFiltration>, "f"_a, "threads"_a = 1, "compute boundary matrix of the filtration (threads = 0 uses all hardware threads)");
+    m.def("coboundary", &coboundary<PyFiltration>, "f"_a, "threads"_a = 1, "compute coboundary matrix of the filtration (threads = 0 uses all hardware threads)");
+    m.def("boundary", &boundary<PyMultiFiltration>, "f"_a, "threads"_a = 1, "compute boundary matrix of the filtration (threads = 0 uses all hardware threads)");
+    m.def("coboundary", &coboundary<PyMultiFiltration>, "f"_a, "threads"_a = 1, "compute coboundary matrix of the filtration (threads = 0 uses all hardware threads)");
 }
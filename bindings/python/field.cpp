@@ -5,6 +5,9 @@ namespace py = pybind11;
 
 #include "field.h"
 
+// Python integers have arbitrary precision, so big numerators and denominators go through their decimal representation
+static py::int_ big_integer(const PyQ::BigInteger& x)  { return py::int_(py::str(x.str())); }
+
 void init_field(py::module& m)
 {
     using namespace pybind11::literals;
@@ -24,8 +27,8 @@ void init_field(py::module& m)
     ;
 
     py::class_<PyQElement>(m, "QElement", "rational number")
-        .def_readonly("numerator",    &PyQElement::numerator,    "numerator")
-        .def_readonly("denominator",  &PyQElement::denominator,  "denominator")
+        .def_property_readonly("numerator",   [](const PyQElement& e) { return big_integer(PyQ().big_numerator(e)); },   "numerator")
+        .def_property_readonly("denominator", [](const PyQElement& e) { return big_integer(PyQ().big_denominator(e)); }, "denominator")
         .def("__repr__",        [](const PyQElement& e) { std::ostringstream oss; oss << e; return oss.str(); })
     ;
 }
@@ -3,5 +3,6 @@
 #include <dionysus/fields/zp.h>
 #include <dionysus/fields/q.h>
 
-using PyZpField = dionysus::ZpField<long>;      // long to be usable with Q in OmniFieldPersistence
-using PyQElement = dionysus::Q<long>::Element;
+using PyZpField  = dionysus::ZpField<long>;      // long to be usable with Q in OmniFieldPersistence
+using PyQ        = dionysus::Q<long>;
+using PyQElement = PyQ::Element;
@@ -1,3 +1,8 @@
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 namespace py = pybind11;
@@ -9,6 +14,9 @@ namespace ba = boost::adaptors;
 #include <dionysus/ordinary-persistence.h>
 #include <dionysus/standard-reduction.h>
 #include <dionysus/clearing-reduction.h>
+#include <dionysus/pipeline-reduction.h>
+#include <dionysus/chunk-reduction.h>
+#include <dionysus/zero-persistence.h>
 
 #include "field.h"
 #include "filtration.h"
@@ -17,18 +25,52 @@ namespace ba = boost::adaptors;
 #include "chain.h"
 #include "progress.h"
 
+// throws unless method is known and supports max_dim
+void
+check_method(const std::string& method, int max_dim)
+{
+    static const std::vector<std::string> methods { "clearing", "pipeline", "chunk", "row", "column", "column_no_negative",
+                                                    "matrix_v", "matrix_v_no_negative" };
+    if (std::find(methods.begin(), methods.end(), method) == methods.end())
+        throw std::runtime_error("Unknown method: " + method);
+    if (max_dim >= 0 && (method == "chunk" || method == "row"))
+        throw std::runtime_error("max_dim is not supported by method: " + method);
+}
+
 template<class Filtration, class Relative>
 py::object
-compute_homology_persistence(const Filtration& filtration, const Relative& relative, PyZpField::Element prime, std::string method, const Progress& progress)
+compute_homology_persistence(const Filtration& filtration, const Relative& relative, PyZpField::Element prime, std::string method, const Progress& progress, int max_dim = -1)
 {
     PyZpField field(prime);
 
+    check_method(method, max_dim);
+
     if (method == "clearing")
     {
         using Persistence = dionysus::OrdinaryPersistence<PyZpField>;
         using Reduction   = dionysus::ClearingReduction<Persistence>;
         Persistence persistence(field);
         Reduction   reduce(persistence);
+        reduce.set_max_dimension(max_dim);
+        reduce(filtration, relative, &Reduction::no_report_pair, progress);
+        return py::cast(std::move(reduce.persistence()));
+    }
+    else if (method == "pipeline")
+    {
+        using Persistence = dionysus::OrdinaryPersistence<PyZpField>;
+        using Reduction   = dionysus::PipelineReduction<Persistence>;
+        Persistence persistence(field);
+        Reduction   reduce(persistence);
+        reduce.set_max_dimension(max_dim);
+        reduce(filtration, relative, &Reduction::no_report_pair, progress);
+        return py::cast(std::move(reduce.persistence()));
+    }
+    else if (method == "chunk")
+    {
+        using Persistence = dionysus::OrdinaryPersistence<PyZpField>;
+        using Reduction   = dionysus::ChunkReduction<Persistence>;
+        Persistence persistence(field);
+        Reduction   reduce(persistence);
         reduce(filtration, relative, &Reduction::no_report_pair, progress);
         return py::cast(std::move(reduce.persistence()));
     }
@@ -44,6 +86,7 @@ compute_homology_persistence(const Filtration& filtration, const Relative& relat
         using Reduction   = dionysus::StandardReduction<Persistence>;
         Persistence persistence(field);
         Reduction   reduce(persistence);
+        reduce.set_max_dimension(max_dim);
         reduce(filtration, relative, &Reduction::no_report_pair, progress);
         return py::cast(std::move(reduce.persistence()));
     } else if (method == "column_no_negative")
@@ -52,6 +95,7 @@ compute_homology_persistence(const Filtration& filtration, const Relative& relat
         using Reduction   = dionysus::StandardReduction<Persistence>;
         Persistence persistence(field);
         Reduction   reduce(persistence);
+        reduce.set_max_dimension(max_dim);
         reduce(filtration, relative, &Reduction::no_report_pair, progress);
         return py::cast(std::move(reduce.persistence()));
     } else if (method == "matrix_v")
@@ -60,6 +104,7 @@ compute_homology_persistence(const Filtration& filtration, const Relative& relat
         using Reduction   = dionysus::StandardReduction<Persistence>;
         Persistence persistence(field);
         Reduction   reduce(persistence);
+        reduce.set_max_dimension(max_dim);
         reduce(filtration, relative, &Reduction::no_report_pair, progress);
         auto v = std::move(reduce.persistence().visitor<0>().v_);
         auto r = std::move(reduce.persistence());
@@ -70,6 +115,7 @@ compute_homology_persistence(const Filtration& filtration, const Relative& relat
         using Reduction   = dionysus::StandardReduction<Persistence>;
         Persistence persistence(field);
         Reduction   reduce(persistence);
+        reduce.set_max_dimension(max_dim);
         reduce(filtration, relative, &Reduction::no_report_pair, progress);
         auto v = std::move(reduce.persistence().visitor<1>().v_);
         auto r = std::move(reduce.persistence());
@@ -78,15 +124,45 @@ compute_homology_persistence(const Filtration& filtration, const Relative& relat
         throw std::runtime_error("Unknown method: " + method);
 }
 
+// union-find; the matrix only records the pairs (and skips everything above dimension 0)
+template<class Filtration>
+py::object
+compute_zero_homology_persistence(const Filtration& filtration, PyZpField::Element prime, const Progress& progress)
+{
+    using Persistence = dionysus::ZeroPersistence<PyReducedMatrix::Index>;
+    Persistence zero;
+    zero(filtration, &Persistence::no_report_pair, progress);
+
+    PyReducedMatrix persistence(PyZpField{prime});
+    persistence.resize(filtration.size());
+    persistence.set_pairs_only();
+    for (PyReducedMatrix::Index i = 0; i < zero.size(); ++i)
+        if (zero.skip(i))
+            persistence.set_skip(i);
+        else if (zero.pair(i) != zero.unpaired())
+            persistence.set_pair(i, zero.pair(i));
+
+    return py::cast(std::move(persistence));
+}
+
 template<class Filtration>
 py::object
-homology_persistence(const Filtration& filtration, PyZpField::Element prime, std::string method, bool progress)
+homology_persistence(const Filtration& filtration, PyZpField::Element prime, std::string method, bool progress, int max_dim)
 {
-    using Cell = typename Filtration::Cell;
+    // union-find gives the pairs, but not V
+    check_method(method, max_dim);
+    if (max_dim == 0 && method != "matrix_v" && method != "matrix_v_no_negative")
+    {
+        if (progress)
+            return compute_zero_homology_persistence(filtration, prime, ShowProgress(filtration.size()));
+        else
+            return compute_zero_homology_persistence(filtration, prime, NoProgress());
+    }
+
     if (progress)
-        return compute_homology_persistence(filtration, [](const Cell&) { return false; }, prime, method, ShowProgress(filtration.size()));
+        return compute_homology_persistence(filtration, dionysus::NoRelative(), prime, method, ShowProgress(filtration.size()), max_dim);
     else
-        return compute_homology_persistence(filtration, [](const Cell&) { return false; }, prime, method, NoProgress());
+        return compute_homology_persistence(filtration, dionysus::NoRelative(), prime, method, NoProgress(), max_dim);
 }
 
 py::object
@@ -99,14 +175,57 @@ relative_homology_persistence(const PyFiltration& filtration, const PyFiltration
         return compute_homology_persistence(filtration, [&relative](const Cell& c) { return relative.contains(c); }, prime, method, NoProgress());
 }
 
+// boundaries of the cells, none reduced yet (see ReducedMatrix.reduce_upto)
+template<class Filtration>
+PyReducedMatrix
+boundary_matrix(const Filtration& filtration, PyZpField::Element prime)
+{
+    using Index = PyReducedMatrix::Index;
+    using Entry = PyReducedMatrix::Entry;
+
+    PyReducedMatrix m(PyZpField{prime});
+    m.resize(filtration.size());
+    for (Index i = 0; i < filtration.size(); ++i)
+    {
+        PyReducedMatrix::Chain chain;
+        for (auto&& x : dionysus::cell_boundary(filtration[i], m.field()))
+            chain.push_back(Entry { x.element(), static_cast<Index>(filtration.index(x.index(), i)) });
+        m.set(i, std::move(chain));
+    }
+    return m;
+}
+
 template<class PyReducedMatrix, class Filtration>
 std::vector<PyDiagram>
-py_init_diagrams(const PyReducedMatrix& m, const Filtration& f)
+py_init_diagrams(const PyReducedMatrix& m, const Filtration& f, long n)
 {
     using Index = typename PyReducedMatrix::Index;
     return init_diagrams(m, f,
                          [](const typename Filtration::Cell& s, Index)      { return s.data(); },       // value
-                         [](Index i) -> PyIndex                             { return i; });             // data
+                         [](Index i) -> PyIndex                             { return i; },              // data
+                         n < 0 ? m.size() : std::min<size_t>(n, m.size()));
+}
+
+// the columns of a pairs-only matrix are empty (see ReducedMatrix::pairs_only())
+template<class PyReducedMatrix>
+void
+check_columns(const PyReducedMatrix& m)
+{
+    if (m.pairs_only())
+        throw std::runtime_error("the matrix records only the pairs (method `pipeline`, or max_dim = 0); it has no columns");
+}
+
+// see dionysus::reduce_upto(); the values are the cells' data
+template<class PyReducedMatrix, class Filtration>
+typename PyReducedMatrix::Index
+reduce_upto_value(PyReducedMatrix& m, const Filtration& f, double value, double seconds)
+{
+    check_columns(m);
+    auto start = std::chrono::steady_clock::now();
+    return dionysus::reduce_upto(m, f, value,
+                                 [](const typename Filtration::Cell& s, typename PyReducedMatrix::Index) { return s.data(); },
+                                 [start,seconds]()
+                                 { return seconds >= 0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > seconds; });
 }
 
 bool
@@ -115,6 +234,7 @@ homologous(PyReducedMatrix& m, PyReducedMatrix::Chain z1, PyReducedMatrix::Chain
     using Entry = PyReducedMatrix::Entry;
     auto entry_cmp = [&m](const Entry& e1, const Entry& e2) { return m.cmp()(e1.index(), e2.index()); };
 
+    check_columns(m);
     std::sort(z1.begin(), z1.end(), entry_cmp);
     std::sort(z2.begin(), z2.end(), entry_cmp);
 
@@ -148,18 +268,35 @@ void export_reduced_matrix(py::module& m, std::string name)
                         return m;
                       }), "field"_a = PyZpField(2), "size"_a = 0)
         .def("__len__",     &PyReducedMatrix::size,         "size of the matrix")
-        .def("__getitem__", &PyReducedMatrix::operator[],   "access the column at a given index")
+        .def("__getitem__", [](const PyReducedMatrix& m, Index i) -> const typename PyReducedMatrix::Chain&
+                            { check_columns(m); return m[i]; },       "access the column at a given index")
         .def("__setitem__", [](PyReducedMatrix* m, Index i, Column c) { m->set(i,std::move(c)); },
                                                             "set the column at a given index")
         .def("__setitem__", [](PyReducedMatrix* m, Index i, Chain c) { m->set(i,std::move(c)); },
                                                             "set the column at a given index")
         .def("pair",        &PyReducedMatrix::pair,         "pair of the given index")
+        .def("reduce_upto", [](PyReducedMatrix& m, Index i, double seconds)
+                            {
+                                check_columns(m);
+                                auto start = std::chrono::steady_clock::now();
+                                return m.reduce_upto(i, [start,seconds]()
+                                       { return seconds >= 0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > seconds; });
+                            }, "i"_a, "seconds"_a = -1,
+                            "reduce the columns from `reduced` up to (but not including) i, stopping after the given number of seconds (if non-negative); returns the new `reduced`")
+        .def("reduce_upto", &reduce_upto_value<PyReducedMatrix, PyFiltration>, "f"_a, "value"_a, "seconds"_a = -1,
+                            "reduce the columns of the cells of the (sorted) filtration f with data up to and including value, stopping after the given number of seconds (if non-negative); returns the new `reduced`")
+        .def("reduce_upto", &reduce_upto_value<PyReducedMatrix, PyMatrixFiltration>, "f"_a, "value"_a, "seconds"_a = -1,
+                            "reduce the columns of the cells of the (sorted) filtration f with data up to and including value, stopping after the given number of seconds (if non-negative); returns the new `reduced`")
+        .def_property_readonly("reduced",       &PyReducedMatrix::reduced,
+                               "number of columns reduced in order (the diagrams of this prefix are final)")
         .def_property_readonly("unpaired",      [](const PyReducedMatrix&) { return PyReducedMatrix::unpaired(); },
                                "index representing lack of pair")
+        .def_property_readonly("pairs_only",    &PyReducedMatrix::pairs_only,
+                               "whether the matrix records only the pairs (method `pipeline`, or max_dim = 0), without the columns")
         .def("homologous",  &homologous,                    "test if two cycles are homologous")
         .def("resize",      &PyReducedMatrix::resize,       "resize the number of columns")
         .def("field",       &PyReducedMatrix::field,        "access the field used for the reduction")
-        .def("__iter__",    [](const PyReducedMatrix& rm)   { return py::make_iterator(rm.columns().begin(), rm.columns().end()); },
+        .def("__iter__",    [](const PyReducedMatrix& rm)   { check_columns(rm); return py::make_iterator(rm.columns().begin(), rm.columns().end()); },
                                 py::keep_alive<0, 1>() /* Essential: keep object alive while iterator exists */,
                                 "iterate over the columns of the matrix")
         .def("__repr__",    [](const PyReducedMatrix& rm)
@@ -183,11 +320,11 @@ void export_reduced_matrix(py::module& m, std::string name)
                     ++i;
                 }
 
-                return py::make_tuple(m.field().prime(), columns, pairs, skips);
+                return py::make_tuple(m.field().prime(), columns, pairs, skips, m.pairs_only());
             },
             [](py::tuple t)                     // __setstate__
             {
-                if (t.size() != 1)
+                if (t.size() != 4 && t.size() != 5)
                     throw std::runtime_error("Invalid state!");
 
                 auto prime = t[0].cast<typename PyReducedMatrix::FieldElement>();
@@ -203,40 +340,54 @@ void export_reduced_matrix(py::module& m, std::string name)
                                                    {
                                                      return typename PyReducedMatrix::Entry { std::get<0>(e), std::get<1>(e) };
                                                    }));
-                    m.set_pair(i,pairs[i]);
+                    if (pairs[i] != m.unpaired())
+                        m.set_pair(i,pairs[i]);
                     m.set_skip(i,skips[i]);
                     ++i;
                 }
+                if (t.size() == 5)
+                    m.set_pairs_only(t[4].cast<bool>());
 
                 return m;
             }
         ));
     ;
 
-    m.def("init_diagrams",      &py_init_diagrams<PyReducedMatrix, PyFiltration>,            "m"_a, "f"_a,  "initialize diagrams from reduced matrix and filtration");
-    m.def("init_diagrams",      &py_init_diagrams<PyReducedMatrix, PyMatrixFiltration>,      "m"_a, "f"_a,  "initialize diagrams from reduced matrix and filtration");
-    m.def("init_diagrams",      &py_init_diagrams<PyReducedMatrix, PyMultiFiltration>,       "m"_a, "f"_a,  "initialize diagrams from reduced matrix and filtration");
-    m.def("init_diagrams",      &py_init_diagrams<PyReducedMatrix, PyLinkedMultiFiltration>, "m"_a, "f"_a,  "initialize diagrams from reduced matrix and filtration");
+    m.def("init_diagrams",      &py_init_diagrams<PyReducedMatrix, PyFiltration>,            "m"_a, "f"_a, "n"_a = -1, "initialize diagrams from reduced matrix and filtration (only its first n cells, if n is non-negative)");
+    m.def("init_diagrams",      &py_init_diagrams<PyReducedMatrix, PyMatrixFiltration>,      "m"_a, "f"_a, "n"_a = -1, "initialize diagrams from reduced matrix and filtration (only its first n cells, if n is non-negative)");
+    m.def("init_diagrams",      &py_init_diagrams<PyReducedMatrix, PyMultiFiltration>,       "m"_a, "f"_a, "n"_a = -1, "initialize diagrams from reduced matrix and filtration (only its first n cells, if n is non-negative)");
+    m.def("init_diagrams",      &py_init_diagrams<PyReducedMatrix, PyLinkedMultiFiltration>, "m"_a, "f"_a, "n"_a = -1, "initialize diagrams from reduced matrix and filtration (only its first n cells, if n is non-negative)");
 }
 
 void init_persistence(py::module& m)
 {
     using namespace pybind11::literals;
     m.def("homology_persistence",   &homology_persistence<PyFiltration>,
-          "filtration"_a, "prime"_a = 2, "method"_a = "clearing", "progress"_a = false,
-          "compute homology persistence of the filtration (pair simplices); method is one of `clearing`, `row`, `column`, or `column_no_negative`");
+          "filtration"_a, "prime"_a = 2, "method"_a = "clearing", "progress"_a = false, "max_dim"_a = -1,
+          "compute homology persistence of the filtration (pair simplices); method is one of `clearing`, `pipeline`, `chunk`, `row`, `column`, or `column_no_negative`; "
+          "`pipeline` reduces the dimensions in parallel, and the matrix records only the pairs (see `ReducedMatrix.pairs_only`); "
+          "max_dim >= 0 computes homology only up to that dimension (not with `chunk` or `row`), and max_dim = 0 with union-find (the matrix records only the pairs), except for `matrix_v` and `matrix_v_no_negative`");
     m.def("homology_persistence",   &homology_persistence<PyMatrixFiltration>,
-          "filtration"_a, "prime"_a = 2, "method"_a = "clearing", "progress"_a = false,
-          "compute homology persistence of the filtration (pair simplices); method is one of `clearing`, `row`, `column`, or `column_no_negative`");
+          "filtration"_a, "prime"_a = 2, "method"_a = "clearing", "progress"_a = false, "max_dim"_a = -1,
+          "compute homology persistence of the filtration (pair simplices); method is one of `clearing`, `pipeline`, `chunk`, `row`, `column`, or `column_no_negative`; "
+          "`pipeline` reduces the dimensions in parallel, and the matrix records only the pairs (see `ReducedMatrix.pairs_only`); "
+          "max_dim >= 0 computes homology only up to that dimension (not with `chunk` or `row`), and max_dim = 0 with union-find (the matrix records only the pairs), except for `matrix_v` and `matrix_v_no_negative`");
     m.def("homology_persistence",   &homology_persistence<PyMultiFiltration>,
-          "filtration"_a, "prime"_a = 2, "method"_a = "clearing", "progress"_a = false,
-          "compute homology persistence of the filtration (pair simplices); method is one of `clearing`, `row`, `column`, or `column_no_negative`");
+          "filtration"_a, "prime"_a = 2, "method"_a = "clearing", "progress"_a = false, "max_dim"_a = -1,
+          "compute homology persistence of the filtration (pair simplices); method is one of `clearing`, `pipeline`, `chunk`, `row`, `column`, or `column_no_negative`; "
+          "`pipeline` reduces the dimensions in parallel, and the matrix records only the pairs (see `ReducedMatrix.pairs_only`); "
+          "max_dim >= 0 computes homology only up to that dimension (not with `chunk` or `row`), and max_dim = 0 with union-find (the matrix records only the pairs), except for `matrix_v` and `matrix_v_no_negative`");
     m.def("homology_persistence",   &homology_persistence<PyLinkedMultiFiltration>,
-          "filtration"_a, "prime"_a = 2, "method"_a = "clearing", "progress"_a = false,
-          "compute homology persistence of the filtration (pair simplices); method is one of `clearing`, `row`, `column`, or `column_no_negative`");
+          "filtration"_a, "prime"_a = 2, "method"_a = "clearing", "progress"_a = false, "max_dim"_a = -1,
+          "compute homology persistence of the filtration (pair simplices); method is one of `clearing`, `pipeline`, `chunk`, `row`, `column`, or `column_no_negative`; "
+          "`pipeline` reduces the dimensions in parallel, and the matrix records only the pairs (see `ReducedMatrix.pairs_only`); "
+          "max_dim >= 0 computes homology only up to that dimension (not with `chunk` or `row`), and max_dim = 0 with union-find (the matrix records only the pairs), except for `matrix_v` and `matrix_v_no_negative`");
+    m.def("boundary_matrix",        &boundary_matrix<PyFiltration>,
+          "filtration"_a, "prime"_a = 2,
+          "boundary matrix of the filtration, with no columns reduced; for progressive reduction with `ReducedMatrix.reduce_upto`");
     m.def("homology_persistence",   &relative_homology_persistence,
           "filtration"_a, "relative"_a, "prime"_a = 2, "method"_a = "clearing", "progress"_a = false,
-          "compute homology persistence of the filtration, relative to a subcomplex; method is one of `clearing`, `row`, `column`, or `column_no_negative`");
+          "compute homology persistence of the filtration, relative to a subcomplex; method is one of `clearing`, `pipeline`, `chunk`, `row`, `column`, or `column_no_negative`");
 
     py::class_<PyMatrixFiltration::Cell>(m, "MatrixFiltrationCell", "Cell-like adapter for a matrix column")
         .def("__repr__",    [](const PyMatrixFiltration::Cell& mfc)
@@ -1,13 +1,17 @@
 #include <cmath>
+#include <limits>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 namespace py = pybind11;
 
 #include <dionysus/rips.h>
+#include <dionysus/rips-cohomology.h>
 
 #include "simplex.h"
 #include "filtration.h"
+#include "field.h"
+#include "diagram.h"
 
 template<class T>
 struct ExplicitDistances
@@ -133,11 +137,63 @@ PyFiltration fill_rips(py::array a, unsigned k, double r)
         throw std::runtime_error("Unknown input dimension: can only process 1D and 2D arrays");
 }
 
+template<class Distances, class Value>
+std::vector<PyDiagram> rips_cohomology_(py::array a, unsigned k, double r, PyZpField::Element prime, const Value& value)
+{
+    using Persistence = dionysus::RipsCohomology<PyZpField, Distances>;
+    using Simplex     = typename Persistence::Simplex;
+
+    Distances   distances(a);
+    Persistence persistence(PyZpField(prime), distances);
+
+    std::vector<PyDiagram> diagrams(k + 1);
+    persistence(k, r,
+                [&diagrams,&value](int d, const Simplex& b, const Simplex& s)
+                {
+                    auto birth = value(b.data()), death = value(s.data());
+                    if (birth != death)         // skip diagonal
+                        diagrams[d].emplace_back(birth, death, 0);
+                },
+                [&diagrams,&value](int d, const Simplex& b)
+                { diagrams[d].emplace_back(value(b.data()), std::numeric_limits<PyDiagram::Value>::infinity(), 0); });
+
+    return diagrams;
+}
+
+std::vector<PyDiagram> rips_cohomology(py::array a, unsigned k, double r, PyZpField::Element prime)
+{
+    auto same = [](PyDiagram::Value x) { return x; };
+    if (a.ndim() == 2)
+    {
+        // PairwiseDistances returns squared distances, so we use r*r and take square roots of the values
+        auto sqrt = [](PyDiagram::Value x) { return std::sqrt(x); };
+        if (a.dtype().is(py::dtype::of<float>()))
+            return rips_cohomology_<PairwiseDistances<float>>(a,k,r*r,prime,sqrt);
+        else if (a.dtype().is(py::dtype::of<double>()))
+            return rips_cohomology_<PairwiseDistances<double>>(a,k,r*r,prime,sqrt);
+        else
+            throw std::runtime_error("Unknown array dtype");
+    } else if (a.ndim() == 1)
+    {
+        if (a.dtype().is(py::dtype::of<float>()))
+            return rips_cohomology_<ExplicitDistances<float>>(a,k,r,prime,same);
+        else if (a.dtype().is(py::dtype::of<double>()))
+            return rips_cohomology_<ExplicitDistances<double>>(a,k,r,prime,same);
+        else
+            throw std::runtime_error("Unknown array dtype");
+    } else
+        throw std::runtime_error("Unknown input dimension: can only process 1D and 2D arrays");
+}
+
 void init_rips(py::module& m)
 {
     using namespace pybind11::literals;
     m.def("fill_rips",  &fill_rips,
           "data"_a, "k"_a, "r"_a,
           "returns (sorted) filtration filled with the k-skeleton of the clique complex built on the points at distance at most r from each other");
+    m.def("rips_cohomology",  &rips_cohomology,
+          "data"_a, "k"_a, "r"_a, "prime"_a = 2,
+          "returns persistence diagrams (in dimensions 0..k) of the cohomology of the same complex as fill_rips(data, k, r), "
+          "computed without storing the filtration; points' data is 0");
 }
 
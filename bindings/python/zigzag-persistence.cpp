@@ -107,62 +107,71 @@ zigzag_homology_persistence(const PyFiltration&     f,
     std::vector<PyDiagram> diagrams;
     PyZpField field(prime);
     PyZigzagPersistence persistence(field);
-    unsigned op = 0;
     unsigned cell = 0;
     std::vector<unsigned>   cells(f.size(), -1);
     PyTimeIndexMap          cells_inv_;
-    for (auto& tt : times)
+
+    // the steps at the same time, in the same direction, form a batch (unless the callback needs to see every step)
+    for (size_t b = 0; b < times.size(); )
     {
-        (*progress)();
+        size_t e = b + 1;
+        if (!callback)
+            while (e < times.size() && times[e].t == times[b].t && times[e].dir == times[b].dir)
+                ++e;
 
-        size_t i = tt.i; float t = tt.t; bool dir = tt.dir;
+        float t = times[b].t; bool dir = times[b].dir;
 
-        auto& c = f[i];
+        std::vector<Index> pairs;
         if (dir)
         {
-            cells_inv_.set(cell, i);
-            cells[i] = cell++;
-
-            Index pair = persistence.add(c.boundary(persistence.field()) |
-                                                    ba::transformed([&](const CellChainEntry& e)
-                                                    {
-                                                        auto idx = f.index(e.index(),i);
-                                                        return ChainEntry(e.element(), cells[idx]);
-                                                    }));
+            std::vector<std::vector<ChainEntry>> chains;
+            for (size_t k = b; k < e; ++k)
+            {
+                size_t i = times[k].i;
+                chains.emplace_back();
+                for (const CellChainEntry& x : f[i].boundary(persistence.field()))
+                    chains.back().emplace_back(x.element(), cells[f.index(x.index(),i)]);
 
-            if (pair != persistence.unpaired())
+                cells_inv_.set(cell, i);
+                cells[i] = cell++;
+            }
+            pairs = persistence.add_batch(chains);
+        } else
+        {
+            std::vector<Index> removed;
+            for (size_t k = b; k < e; ++k)
             {
-                auto t_birth = times[pair].t;
-                if (t_birth != t)
-                {
-                    int dim = c.dimension()-1;
-                    while (dim+1 > diagrams.size())
-                        diagrams.emplace_back();
-                    diagrams[dim].emplace_back(t_birth, t, pair);
-                }
+                size_t i = times[k].i;
+                removed.push_back(cells[i]);
+                cells_inv_.remove(cells[i]);
+                cells[i] = -1;
             }
+            pairs = persistence.remove_batch(removed);
+        }
 
-            ++op;
-        } else
+        for (size_t k = b; k < e; ++k)
         {
-            Index pair = persistence.remove(cells[i]);
-            cells_inv_.remove(cells[i]);
-            cells[i] = -1;
+            (*progress)();
+
+            size_t i = times[k].i;
+            Index pair = pairs[k - b];
             if (pair != persistence.unpaired())
             {
                 auto t_birth = times[pair].t;
                 if (t_birth != t)
                 {
-                    int dim = c.dimension();
+                    int dim = dir ? f[i].dimension() - 1 : f[i].dimension();
                     while (dim+1 > diagrams.size())
                         diagrams.emplace_back();
                     diagrams[dim].emplace_back(t_birth, t, pair);
                 }
             }
-            ++op;
+
+            if (callback)
+                callback(i,t,dir,&persistence,&cells_inv_);
         }
 
-        callback(i,t,dir,&persistence,&cells_inv_);
+        b = e;
     }
 
     // add infinite points
@@ -326,7 +335,7 @@ void init_zigzag_persistence(py::module& m)
 {
     using namespace pybind11::literals;
     m.def("zigzag_homology_persistence",   &zigzag_homology_persistence, "filtration"_a, "times"_a, "prime"_a = 2,
-                                                                         "callback"_a = Callback([](size_t, float, bool, const PyZigzagPersistence*, const PyTimeIndexMap*){}),
+                                                                         "callback"_a = Callback(),
                                                                          "progress"_a = false,
           R"(
           compute zigzag homology persistence of the filtration with respect to the given times
@@ -342,6 +351,7 @@ void init_zigzag_persistence(py::module& m)
                           `d` is the "direction" (`True` if the simplex is being added, `False` if it`s being removed),
                           `zz` is the current state of the :class:`~dionysus._dionysus.ZigzagPersistence`,
                           `cells` is the map from the internal indices of the zigzag representation to the filtration indices,
+                          without a callback, the simplices that enter (or leave) at the same time are processed as a batch,
               progress:   show a progress bar.
 
           Returns:
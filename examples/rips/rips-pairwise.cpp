@@ -6,11 +6,14 @@
 
 #include <dionysus/distances.h>
 #include <dionysus/rips.h>
+#include <dionysus/combinatorial-simplex.h>
 #include <dionysus/filtration.h>
+#include <dionysus/flat-filtration.h>
 #include <dionysus/fields/zp.h>
 #include <dionysus/fields/z2.h>
 #include <dionysus/ordinary-persistence.h>
 #include <dionysus/cohomology-persistence.h>
+#include <dionysus/compact-cohomology-persistence.h>
 #include <dionysus/zigzag-persistence.h>
 #include <dionysus/standard-reduction.h>
 #include <dionysus/row-reduction.h>
@@ -30,13 +33,17 @@ typedef         PairDistances::DistanceType                             Distance
 typedef         PairDistances::IndexType                                Vertex;
 
 typedef         d::Rips<PairDistances>                                  Generator;
+//typedef         d::Rips<PairDistances,
+//                        d::CombinatorialSimplex<Vertex>>                Generator;
 typedef         Generator::Simplex                                      Simplex;
 typedef         d::Filtration<Simplex>                                  Filtration;
+//typedef         d::FlatFiltration<Simplex>                              Filtration;
 
 typedef         d::Z2Field                                              K;
 //typedef         d::ZpField<>                                            K;
 //typedef         d::OrdinaryPersistence<K>                               Persistence;
 typedef         d::PairRecorder<d::CohomologyPersistence<K>>            Persistence;
+//typedef         d::PairRecorder<d::CompactCohomologyPersistence<K>>     Persistence;
 //typedef         d::ZigzagPersistence<K>                                 Persistence;
 
 int main(int argc, char* argv[])
@@ -0,0 +1,70 @@
+#ifndef DIONYSUS_APPARENT_PAIRS_H
+#define DIONYSUS_APPARENT_PAIRS_H
+
+#include <vector>
+#include <limits>
+
+#include "chain.h"
+#include "fields/z2.h"
+
+namespace dionysus
+{
+
+// Apparent pairs: (s,t), where s is the youngest facet of t and t is the oldest
+// cofacet of s. No column before t contains s, so t needs no additions: its
+// boundary is already reduced, with pivot s, and s is positive. In Rips
+// filtrations (sorted by Rips::Comparison) most pairs are apparent.
+// boundary(t, f) calls f(s) for every facet s of cell t (in the filtration order).
+// Returns the partner of every cell (s <-> t), or unpaired for cells that aren't
+// in an apparent pair.
+template<class Index, class Boundary>
+std::vector<Index>
+apparent_pairs_from(Index n, const Boundary& boundary)
+{
+    const Index unpaired = std::numeric_limits<Index>::max();
+
+    std::vector<Index>  youngest_facet(n, unpaired);
+    std::vector<Index>  oldest_cofacet(n, unpaired);
+
+    for (Index t = 0; t < n; ++t)
+        boundary(t, [&youngest_facet,&oldest_cofacet,unpaired,t](Index s)
+        {
+            if (youngest_facet[t] == unpaired || youngest_facet[t] < s)
+                youngest_facet[t] = s;
+            if (oldest_cofacet[s] == unpaired)
+                oldest_cofacet[s] = t;
+        });
+
+    std::vector<Index>  pairs(n, unpaired);
+    for (Index t = 0; t < n; ++t)
+    {
+        Index s = youngest_facet[t];
+        if (s != unpaired && oldest_cofacet[s] == t)
+        {
+            pairs[s] = t;
+            pairs[t] = s;
+        }
+    }
+    return pairs;
+}
+
+// Apparent pairs of a filtration; cells in the relative subcomplex are ignored.
+template<class Index = unsigned, class Filtration, class Relative = NoRelative>
+std::vector<Index>
+apparent_pairs(const Filtration& filtration, const Relative& relative = Relative())
+{
+    Z2Field k;
+    return apparent_pairs_from<Index>(filtration.size(), [&filtration,&relative,&k](Index t, const auto& f)
+    {
+        const auto& c = filtration[t];
+        if (relative(c))
+            return;
+        for (auto&& x : cell_boundary(c, k))
+            if (!relative(x.index()))
+                f(filtration.index(x.index(), t));
+    });
+}
+
+}
+
+#endif
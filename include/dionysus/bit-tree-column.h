@@ -0,0 +1,98 @@
+#ifndef DIONYSUS_BIT_TREE_COLUMN_H
+#define DIONYSUS_BIT_TREE_COLUMN_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace dionysus
+{
+
+// Set of indices stored as a hierarchical bitset: a bit at one level is set iff the
+// corresponding 64-bit word of the level below is non-zero. Over Z2, adding an index
+// to a column is a toggle, and the largest index (the pivot) is found by following
+// the highest set bits from the root, one count-leading-zeros per level.
+class BitTree
+{
+    public:
+        typedef     uint64_t                Word;
+
+        static constexpr unsigned   bits_per_word = 64;
+
+    public:
+        // make room for indices in [0, n); the set must be empty
+        void        reserve(size_t n);
+        size_t      capacity() const                            { return levels_.empty() ? 0 : size_t(level_size(0)) * bits_per_word; }
+
+        bool        empty() const                               { return levels_.empty() || words_[levels_.back()] == 0; }
+
+        void        toggle(size_t i);
+        size_t      max() const;                                // undefined if empty
+
+        // remove the largest index and return it
+        size_t      pop_max()                                   { size_t i = max(); toggle(i); return i; }
+
+    private:
+        size_t      level_size(size_t l) const                  { return (l + 1 < levels_.size() ? levels_[l+1] : words_.size()) - levels_[l]; }
+
+        static unsigned
+                    highest_bit(Word w)                         { return bits_per_word - 1 - __builtin_clzll(w); }
+
+    private:
+        std::vector<Word>       words_;
+        std::vector<size_t>     levels_;        // offsets of the levels in words_, from the leaves to the root
+};
+
+inline
+void
+BitTree::
+reserve(size_t n)
+{
+    if (n <= capacity())
+        return;
+
+    levels_.clear();
+    size_t total = 0;
+    size_t sz    = (n + bits_per_word - 1) / bits_per_word;
+    while (true)
+    {
+        levels_.push_back(total);
+        total += sz;
+        if (sz == 1)
+            break;
+        sz = (sz + bits_per_word - 1) / bits_per_word;
+    }
+    std::vector<Word>(total, 0).swap(words_);
+}
+
+inline
+void
+BitTree::
+toggle(size_t i)
+{
+    for (size_t l = 0; l < levels_.size(); ++l)
+    {
+        Word& w    = words_[levels_[l] + i / bits_per_word];
+        Word  bit  = Word(1) << (i % bits_per_word);
+        bool  was  = w != 0;
+        w ^= bit;
+        if ((w != 0) == was)        // the word's emptiness didn't change; nothing to propagate
+            break;
+        i /= bits_per_word;
+    }
+}
+
+inline
+size_t
+BitTree::
+max() const
+{
+    size_t i = 0;
+    for (size_t l = levels_.size(); l-- > 0; )
+        i = i * bits_per_word + highest_bit(words_[levels_[l] + i]);
+    return i;
+}
+
+}
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef DIONYSUS_BOUNDARY_MATRIX_H
+#define DIONYSUS_BOUNDARY_MATRIX_H
+
+#include <vector>
+#include <iostream>
+
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include "chain.h"
+#include "parallel.h"
+
+namespace dionysus
+{
+
+namespace detail
+{
+    // Integer coefficients, used to record boundaries independently of the field
+    struct IntegerCoefficients
+    {
+        typedef     int             Element;
+
+        Element     id() const                          { return 1; }
+        Element     zero() const                        { return 0; }
+        Element     init(int a) const                   { return a; }
+        Element     neg(Element a) const                { return -a; }
+    };
+}
+
+/**
+ * BoundaryMatrix
+ *
+ * Boundary matrix of a filtration in compressed sparse column form: column i
+ * occupies positions [offsets()[i], offsets()[i+1]) of indices() and
+ * coefficients(); dimensions()[i] is the dimension of the i-th cell.
+ * The boundaries are computed and looked up in the filtration once (in
+ * parallel over the columns), so running several reductions, or one reduction
+ * over several fields, doesn't repeat the work.
+ *
+ * BoundaryMatrix can be passed to the reductions in place of the filtration
+ * it was built from; its cells are lightweight views that know their index.
+ * The coefficients are integers, mapped into the reduction's field with init().
+ */
+template<class Index_ = unsigned>
+class BoundaryMatrix
+{
+    public:
+        typedef         Index_                                      Index;
+        typedef         short                                       Coefficient;
+        typedef         short unsigned                              Dimension;
+
+        typedef         std::vector<size_t>                         Offsets;
+        typedef         std::vector<Index>                          Indices;
+        typedef         std::vector<Coefficient>                    Coefficients;
+        typedef         std::vector<Dimension>                      Dimensions;
+
+        class           Cell;
+        class           CellIterator;
+
+        typedef         CellIterator                                OrderConstIterator;
+        typedef         CellIterator                                OrderIterator;
+
+    public:
+                        BoundaryMatrix()                            = default;
+
+        // threads = 0 uses all available hardware threads
+        template<class Filtration>
+                        BoundaryMatrix(const Filtration& f, unsigned threads = 1);
+
+        // Filtration interface
+        Cell            operator[](size_t i) const                  { return Cell(this, i); }
+        size_t          index(const Cell& c, size_t) const          { return c.index(); }
+        size_t          size() const                                { return dimensions_.size(); }
+
+        CellIterator    begin() const                               { return CellIterator(this, 0); }
+        CellIterator    end() const                                 { return CellIterator(this, size()); }
+
+        // CSR arrays
+        const Offsets&      offsets() const                         { return offsets_; }
+        const Indices&      indices() const                         { return indices_; }
+        const Coefficients& coefficients() const                    { return coefficients_; }
+        const Dimensions&   dimensions() const                      { return dimensions_; }
+
+        size_t          nonzeros() const                            { return indices_.size(); }
+
+    private:
+        Offsets         offsets_;
+        Indices         indices_;
+        Coefficients    coefficients_;
+        Dimensions      dimensions_;
+};
+
+template<class I>
+class BoundaryMatrix<I>::Cell
+{
+    public:
+        template<class Field>
+        struct ToEntry
+        {
+            typedef     ChainEntry<Field, Cell>                     result_type;
+
+            result_type operator()(size_t k) const                  { return result_type(field->init(m->coefficients_[k]), Cell(m, m->indices_[k])); }
+
+            const BoundaryMatrix*   m;
+            const Field*            field;
+        };
+
+        template<class Field>
+        using BoundaryChainRange = boost::iterator_range<boost::transform_iterator<ToEntry<Field>, boost::counting_iterator<size_t>>>;
+
+    public:
+                        Cell(const BoundaryMatrix* m = nullptr, size_t i = 0):
+                            m_(m), i_(i)                            {}
+
+        short unsigned  dimension() const                           { return m_->dimensions_[i_]; }
+        size_t          index() const                               { return i_; }
+        const BoundaryMatrix*
+                        matrix() const                              { return m_; }
+
+        template<class Field>
+        BoundaryChainRange<Field>
+                        boundary(const Field& field) const
+        {
+            ToEntry<Field> to_entry { m_, &field };
+            boost::counting_iterator<size_t> b(m_->offsets_[i_]), e(m_->offsets_[i_ + 1]);
+            return BoundaryChainRange<Field>(boost::make_transform_iterator(b, to_entry),
+                                             boost::make_transform_iterator(e, to_entry));
+        }
+
+        bool            operator==(const Cell& other) const         { return i_ == other.i_; }
+        bool            operator!=(const Cell& other) const         { return i_ != other.i_; }
+
+        friend
+        std::ostream&   operator<<(std::ostream& out, const Cell& c)    { out << c.i_; return out; }
+
+    private:
+        const BoundaryMatrix*   m_;
+        size_t                  i_;
+};
+
+// Dereferences to a cell stored in the iterator (so that range-for loops can bind references)
+template<class I>
+class BoundaryMatrix<I>::CellIterator:
+    public boost::iterator_facade<CellIterator, const Cell, boost::random_access_traversal_tag>
+{
+    public:
+                        CellIterator(const BoundaryMatrix* m = nullptr, size_t i = 0):
+                            c_(m, i)                                {}
+
+    private:
+        friend class    boost::iterator_core_access;
+
+        const Cell&     dereference() const                         { return c_; }
+        bool            equal(const CellIterator& other) const      { return c_.index() == other.c_.index(); }
+        void            increment()                                 { advance(1); }
+        void            decrement()                                 { advance(-1); }
+        void            advance(std::ptrdiff_t n)                   { c_ = Cell(c_.matrix(), c_.index() + n); }
+        std::ptrdiff_t  distance_to(const CellIterator& other) const    { return other.c_.index() - c_.index(); }
+
+        Cell            c_;
+};
+
+}
+
+template<class I>
+template<class Filtration>
+dionysus::BoundaryMatrix<I>::
+BoundaryMatrix(const Filtration& f, unsigned threads)
+{
+    typedef     detail::IntegerCoefficients                     Field;
+    Field       field;
+
+    size_t n = f.size();
+    offsets_.resize(n + 1);
+    dimensions_.resize(n);
+
+    // count the entries in each column
+    offsets_[0] = 0;
+    parallel_for(n, threads, [this,&f,&field](size_t b, size_t e)
+    {
+        for (size_t i = b; i < e; ++i)
+        {
+            const auto& c = f[i];
+            dimensions_[i] = c.dimension();
+
+            size_t count = 0;
+            for (auto&& x : cell_boundary(c, field)) { (void) x; ++count; }
+            offsets_[i + 1] = count;
+        }
+    });
+    for (size_t i = 0; i < n; ++i)
+        offsets_[i + 1] += offsets_[i];
+
+    // fill the columns
+    indices_.resize(offsets_[n]);
+    coefficients_.resize(offsets_[n]);
+    parallel_for(n, threads, [this,&f,&field](size_t b, size_t e)
+    {
+        for (size_t i = b; i < e; ++i)
+        {
+            size_t k = offsets_[i];
+            for (auto&& x : cell_boundary(f[i], field))
+            {
+                indices_[k]      = f.index(x.index(), i);
+                coefficients_[k] = x.element();
+                ++k;
+            }
+        }
+    });
+}
+
+#endif
@@ -4,6 +4,8 @@
 #include <set>
 #include <vector>
 #include <list>
+#include <utility>
+#include <type_traits>
 
 #include "fields/z2.h"
 
@@ -63,6 +65,68 @@ struct ChainEntry: public FieldElement<Field_>, public Extra...
     Index       i;
 };
 
+namespace detail
+{
+    template<class Cell, class Field>
+    auto cell_boundary(const Cell& c, const Field& field, int) -> decltype(c.faces(field))      { return c.faces(field); }
+
+    template<class Cell, class Field>
+    auto cell_boundary(const Cell& c, const Field& field, long) -> decltype(c.boundary(field))  { return c.boundary(field); }
+}
+
+// Boundary of a cell, as used by the reduction algorithms: cells that can
+// describe their faces as lightweight views (Simplex::faces()) do so, the rest
+// fall back on boundary(field).
+template<class Cell, class Field>
+auto        cell_boundary(const Cell& c, const Field& field) -> decltype(detail::cell_boundary(c, field, 0))
+{ return detail::cell_boundary(c, field, 0); }
+
+template<class Cell, class Field>
+using CellBoundaryEntry = typename std::decay<decltype(*std::begin(cell_boundary(std::declval<const Cell&>(), std::declval<const Field&>())))>::type;
+
+namespace detail
+{
+    // x + a*y; fields that can do it with a single reduction provide muladd()
+    template<class Field>
+    auto muladd(const Field& field, typename Field::Element x, typename Field::Element a, typename Field::Element y, int)
+        -> decltype(field.muladd(x, a, y))                              { return field.muladd(x, a, y); }
+
+    template<class Field>
+    typename Field::Element
+         muladd(const Field& field, typename Field::Element x, typename Field::Element a, typename Field::Element y, long)
+                                                                        { return field.add(x, field.mul(a, y)); }
+
+    template<class Field>
+    typename Field::Element
+         muladd(const Field& field, typename Field::Element x, typename Field::Element a, typename Field::Element y)
+                                                                        { return muladd(field, x, a, y, 0); }
+
+    // the canonical representative of x, for fields that provide normalize() (ZpField)
+    template<class Field>
+    auto normalize(const Field& field, typename Field::Element x, int)
+        -> typename std::enable_if<std::is_same<decltype(field.normalize(x)), typename Field::Element>::value,
+                                   typename Field::Element>::type   { return field.normalize(x); }
+
+    template<class Field>
+    typename Field::Element
+         normalize(const Field&, typename Field::Element x, long)   { return x; }
+
+    template<class Field>
+    typename Field::Element
+         normalize(const Field& field, typename Field::Element x)   { return normalize(field, x, 0); }
+
+    // Per-thread buffer that chain additions merge into; see Chain<C1>::addto()
+    template<class C>
+    C&      scratch_chain()                 { static thread_local C c; return c; }
+}
+
+// Relative predicate that accepts everything (and so never materializes a face)
+struct NoRelative
+{
+    template<class Cell>
+    bool    operator()(const Cell&) const   { return false; }
+};
+
 template<class C1>
 struct Chain
 {
@@ -81,9 +145,15 @@ struct Chain
         void equal_drop(Iter it) const          {}
     };
 
-    // x += a*y
+    // x += a*y; merges through the calling thread's scratch chain
     template<class C2, class Field, class Cmp, class Visitor_ = Visitor>
-    static void addto(C1& x, typename Field::Element a, const C2& y, const Field& field, const Cmp& cmp, const Visitor_& = Visitor_());
+    static void addto(C1& x, typename Field::Element a, const C2& y, const Field& field, const Cmp& cmp, const Visitor_& visitor = Visitor_())
+    { addto(x, a, y, field, cmp, detail::scratch_chain<C1>(), visitor); }
+
+    // x += a*y; the result is merged into scratch, which then trades storage
+    // with x, so once scratch grows large enough, additions stop allocating
+    template<class C2, class Field, class Cmp, class Visitor_ = Visitor>
+    static void addto(C1& x, typename Field::Element a, const C2& y, const Field& field, const Cmp& cmp, C1& scratch, const Visitor_& = Visitor_());
 };
 
 template<class T>
@@ -108,6 +178,12 @@ struct Chain<std::list<T>>
     template<class C2, class Field, class Cmp, class Visitor_ = Visitor>
     static void addto(std::list<T>& x, typename Field::Element a, const C2& y,
                       const Field& field, const Cmp& cmp, const Visitor_& visitor = Visitor_());
+
+    // lists are updated in place; scratch is unused
+    template<class C2, class Field, class Cmp, class Visitor_ = Visitor>
+    static void addto(std::list<T>& x, typename Field::Element a, const C2& y,
+                      const Field& field, const Cmp& cmp, std::list<T>&, const Visitor_& visitor = Visitor_())
+    { addto(x, a, y, field, cmp, visitor); }
 };
 
 
@@ -137,6 +213,12 @@ struct Chain<std::set<T,TCmp>>
     template<class Field, class Cmp, class Visitor_ = Visitor>
     static void addto(std::set<T,TCmp>& x, typename Field::Element a, T&& y,
                       const Field& field, const Cmp& cmp, const Visitor_& = Visitor_());
+
+    // sets are updated in place; scratch is unused
+    template<class C2, class Field, class Cmp, class Visitor_ = Visitor>
+    static void addto(std::set<T,TCmp>& x, typename Field::Element a, const C2& y,
+                      const Field& field, const Cmp& cmp, std::set<T,TCmp>&, const Visitor_& visitor = Visitor_())
+    { addto(x, a, y, field, cmp, visitor); }
 };
 
 }
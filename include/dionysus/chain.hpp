@@ -26,8 +26,7 @@ addto(std::list<T>& x, typename Field::Element a, const C2& y, const Field& fiel
             visitor.second(nw_x);
         } else
         {
-            Element ay = field.mul(a, cur_y->element());
-            Element r  = field.add(cur_x->element(), ay);
+            Element r  = detail::muladd(field, cur_x->element(), a, cur_y->element());
             if (field.is_zero(r))
             {
                 visitor.equal_drop(cur_x);
@@ -74,8 +73,7 @@ addto(std::set<T,TCmp>& x, typename Field::Element a, const C2& y, const Field&
             visitor.second(nw);
         } else
         {
-            Element ay = field.mul(a, cur_y->element());
-            Element r  = field.add(cur_x->element(), ay);
+            Element r  = detail::muladd(field, cur_x->element(), a, cur_y->element());
             if (field.is_zero(r))
             {
                 visitor.equal_drop(cur_x);
@@ -108,8 +106,7 @@ addto(std::set<T,TCmp>& x, typename Field::Element a, T&& y, const Field& field,
         visitor.second(nw);
     } else
     {
-        Element ay = field.mul(a, y.element());
-        Element r  = field.add(cur_x->element(), ay);
+        Element r  = detail::muladd(field, cur_x->element(), a, y.element());
         if (field.is_zero(r))
         {
             visitor.equal_drop(cur_x);
@@ -127,11 +124,11 @@ template<class C1>
 template<class C2, class Field, class Cmp, class Visitor_>
 void
 dionysus::Chain<C1>::
-addto(C1& x, typename Field::Element a, const C2& y, const Field& field, const Cmp& cmp, const Visitor_& visitor)
+addto(C1& x, typename Field::Element a, const C2& y, const Field& field, const Cmp& cmp, C1& res, const Visitor_& visitor)
 {
     typedef typename Field::Element                     Element;
 
-    C1 res;
+    res.clear();
 
     auto cur_x = std::begin(x),
          end_x = std::end(x);
@@ -154,8 +151,7 @@ addto(C1& x, typename Field::Element a, const C2& y, const Field& field, const C
             ++cur_y;
         } else
         {
-            Element ay = field.mul(a, cur_y->element());
-            Element r  = field.add(cur_x->element(), ay);
+            Element r  = detail::muladd(field, cur_x->element(), a, cur_y->element());
             if (field.is_zero(r))
                 visitor.equal_drop(cur_x);
             else
@@ -185,4 +181,5 @@ addto(C1& x, typename Field::Element a, const C2& y, const Field& field, const C
     }
 
     x.swap(res);
+    res.clear();        // destroy the old entries now (they may be hooked into other structures)
 }
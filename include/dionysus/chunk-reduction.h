@@ -0,0 +1,64 @@
+#ifndef DIONYSUS_CHUNK_REDUCTION_H
+#define DIONYSUS_CHUNK_REDUCTION_H
+
+#include <vector>
+#include <tuple>
+
+#include "parallel.h"
+
+namespace dionysus
+{
+
+// Mid-level interface, like ClearingReduction, following the chunk algorithm of
+// Bauer, Kerber, and Reininghaus ("Clear and compress"). The filtration is split
+// into contiguous chunks. In the local phase, the chunks are reduced in parallel
+// (by decreasing dimension, with clearing), each column only while its pivot
+// stays in its chunk; such a pivot is final. The remaining (global) columns are
+// compressed in parallel, by eliminating the entries that are pivots of local
+// columns, and then reduced sequentially. The columns stay valid columns of R,
+// and the pairs are the same as those of StandardReduction.
+// Visitors are not supported: the additions happen in no sequential order.
+template<class Persistence_>
+class ChunkReduction
+{
+    public:
+        using Persistence = Persistence_;
+        using Field       = typename Persistence::Field;
+        using Index       = typename Persistence::Index;
+        using Chain       = typename Persistence::Chain;
+
+        static_assert(std::tuple_size<typename Persistence::VisitorsTuple>::value == 0, "ChunkReduction doesn't call visitors");
+
+    public:
+                    ChunkReduction(Persistence& persistence, unsigned threads = 0):
+                        persistence_(persistence), threads_(threads)    {}
+
+        template<class Filtration, class Relative, class ReportPair, class Progress>
+        void            operator()(const Filtration& f, const Relative& relative, const ReportPair& report_pair, const Progress& progress);
+
+        template<class Filtration, class ReportPair>
+        void            operator()(const Filtration& f, const ReportPair& report_pair);
+
+        template<class Filtration>
+        void            operator()(const Filtration& f)             { return (*this)(f, &no_report_pair); }
+
+        static void     no_report_pair(int, Index, Index)           {}
+        static void     no_progress()                               {}
+
+        const Persistence&
+                        persistence() const                         { return persistence_; }
+        Persistence&    persistence()                               { return persistence_; }
+
+    private:
+        void            compress(Index j);
+
+    private:
+        Persistence&    persistence_;
+        unsigned        threads_;
+};
+
+}
+
+#include "chunk-reduction.hpp"
+
+#endif
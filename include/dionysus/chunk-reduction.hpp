@@ -0,0 +1,161 @@
+#include <cmath>
+#include <algorithm>
+
+#include <boost/range/adaptors.hpp>
+namespace ba = boost::adaptors;
+
+template<class P>
+template<class Filtration, class ReportPair>
+void
+dionysus::ChunkReduction<P>::
+operator()(const Filtration& filtration, const ReportPair& report_pair)
+{
+    (*this)(filtration, NoRelative(), report_pair, &no_progress);
+}
+
+template<class P>
+template<class Filtration, class Relative, class ReportPair, class Progress>
+void
+dionysus::ChunkReduction<P>::
+operator()(const Filtration& filtration, const Relative& relative, const ReportPair& report_pair, const Progress& progress)
+{
+    typedef     typename Filtration::Cell                       Cell;
+    typedef     CellBoundaryEntry<Cell, Field>                  CellChainEntry;
+    typedef     ChainEntry<Field, Index>                        ChainEntry;
+
+    Index n = filtration.size();
+    persistence_.resize(n);
+
+    int max_dim = -1;
+    for (Index i = 0; i < n; ++i)
+    {
+        progress();
+        const auto& c = filtration[i];
+        max_dim = std::max<int>(max_dim, c.dimension());
+        if (relative(c))
+            persistence_.set_skip(i);
+    }
+
+    // boundaries
+    parallel_for(n, threads_, [this,&filtration,&relative](size_t b, size_t e)
+    {
+        for (Index i = b; i < e; ++i)
+        {
+            if (persistence_.skip(i))
+                continue;
+
+            auto& c = persistence_.column(i);
+            for (auto&& x : cell_boundary(filtration[i], persistence_.field()) |
+                            ba::filtered([&relative](const CellChainEntry& e) { return !relative(e.index()); }))
+                c.push_back(ChainEntry(x.element(), filtration.index(x.index(), i)));
+            persistence_.sort(c);
+        }
+    });
+
+    unsigned threads = default_threads(threads_);
+    size_t   chunk   = threads == 1 ? static_cast<size_t>(std::sqrt(double(n))) : (n + threads - 1) / threads;
+    chunk            = std::max<size_t>(chunk, 1);
+    size_t   chunks  = (n + chunk - 1) / chunk;
+
+    auto     chains  = [this](Index o) -> const Chain&  { return persistence_[o]; };
+
+    // local phase
+    std::vector<char> global(n, false);
+    for (int d = max_dim; d >= 0; --d)
+        parallel_for(chunks, threads_, [&,d](size_t cb, size_t ce)
+        {
+            for (size_t ch = cb; ch < ce; ++ch)
+            {
+                Index b = ch * chunk,
+                      e = std::min<size_t>(b + chunk, n);
+
+                // a pivot below the chunk isn't final, so it's treated as new
+                auto pairs = [this,b](Index l) { return l < b ? persistence_.unpaired() : persistence_.pair(l); };
+
+                for (Index j = b; j < e; ++j)
+                {
+                    if (persistence_.skip(j) || filtration[j].dimension() != d || persistence_.pair(j) != persistence_.unpaired())
+                        continue;
+
+                    Index l = persistence_.reduce(j, persistence_.column(j), chains, pairs);
+                    if (l == persistence_.unpaired())
+                        continue;
+
+                    if (l < b)
+                        global[j] = true;
+                    else
+                    {
+                        persistence_.set_pair(l, j);
+                        persistence_.column(l).clear();     // clearing
+                    }
+                }
+            }
+        });
+
+    // compress the global columns
+    std::vector<Index> globals;
+    for (Index j = 0; j < n; ++j)
+        if (global[j])
+            globals.push_back(j);
+
+    parallel_for(globals.size(), threads_, [this,&globals](size_t b, size_t e)
+    {
+        for (size_t k = b; k < e; ++k)
+            compress(globals[k]);
+    });
+
+    // global phase
+    for (int d = max_dim; d >= 0; --d)
+        for (Index j : globals)
+        {
+            if (filtration[j].dimension() != d)
+                continue;
+
+            if (persistence_.pair(j) != persistence_.unpaired())
+            {
+                persistence_.column(j).clear();             // clearing
+                continue;
+            }
+
+            Index l = persistence_.reduce(j);
+            if (l != persistence_.unpaired())
+                persistence_.column(l).clear();
+        }
+
+    for (Index j = 0; j < n; ++j)
+    {
+        Index pair = persistence_.pair(j);
+        if (!persistence_.skip(j) && pair != persistence_.unpaired() && pair < j)
+            report_pair(filtration[j].dimension(), pair, j);
+    }
+}
+
+// Eliminate from column j every entry that's the pivot of a (final) local column
+// preceding j; adding such a column only changes the entries below its pivot.
+template<class P>
+void
+dionysus::ChunkReduction<P>::
+compress(Index j)
+{
+    auto&        c         = persistence_.column(j);
+    const Field& field     = persistence_.field();
+    auto         entry_cmp = [this](const typename Chain::value_type& e1, const typename Chain::value_type& e2)
+                             { return this->persistence_.cmp()(e1.index(), e2.index()); };
+
+    size_t above = 0;           // entries at the end of c that stay
+    while (above < c.size())
+    {
+        auto& e = c[c.size() - 1 - above];
+        Index i = e.index();
+        Index k = persistence_.pair(i);
+        if (k == persistence_.unpaired() || k < i || j < k)
+        {
+            ++above;
+            continue;
+        }
+
+        const Chain& co = persistence_[k];
+        auto         m  = field.neg(field.div(e.element(), co.back().element()));
+        dionysus::Chain<Chain>::addto(c, m, co, field, entry_cmp);
+    }
+}
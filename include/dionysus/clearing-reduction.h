@@ -1,12 +1,15 @@
 #ifndef DIONYSUS_CLEARING_REDUCTION_H
 #define DIONYSUS_CLEARING_REDUCTION_H
 
+#include "reduction.h"
+#include "apparent-pairs.h"
+
 namespace dionysus
 {
 
 // Mid-level interface
 template<class Persistence_>
-class ClearingReduction
+class ClearingReduction: public ReductionOptions<typename Persistence_::Index>
 {
     public:
         using Persistence = Persistence_;
@@ -29,12 +32,18 @@ class ClearingReduction
         static void     no_report_pair(int, Index, Index)           {}
         static void     no_progress()                               {}
 
+        // pair the apparent pairs (see apparent_pairs()) without reducing their columns; they are
+        // found from the cells' boundaries up front, but, as without them, cleared columns are never stored
+        void            set_apparent_pairs(bool flag = true)        { apparent_pairs_ = flag; }
+        bool            apparent_pairs() const                      { return apparent_pairs_; }
+
         const Persistence&
                         persistence() const                         { return persistence_; }
         Persistence&    persistence()                               { return persistence_; }
 
     private:
         Persistence&  persistence_;
+        bool          apparent_pairs_ = false;
 };
 
 }
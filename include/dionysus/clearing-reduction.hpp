@@ -10,8 +10,7 @@ void
 dionysus::ClearingReduction<P>::
 operator()(const Filtration& filtration, const ReportPair& report_pair)
 {
-    using Cell = typename Filtration::Cell;
-    (*this)(filtration, [](const Cell&) { return false; }, report_pair, &no_progress);
+    (*this)(filtration, NoRelative(), report_pair, &no_progress);
 }
 
 template<class P>
@@ -21,6 +20,38 @@ dionysus::ClearingReduction<P>::
 operator()(const Filtration& filtration, const Relative& relative, const ReportPair& report_pair, const Progress& progress)
 {
     persistence_.resize(filtration.size());
+    this->statistics_ = ReductionStatistics();
+
+    typedef     typename Filtration::Cell                       Cell;
+    typedef     CellBoundaryEntry<Cell, Field>                  CellChainEntry;
+    typedef     ChainEntry<Field, Index>                        ChainEntry;
+
+    auto set_boundary = [this,&filtration,&relative](Index i)
+    {
+        // It's fortuitous that indices don't change the filtration. It means
+        // the lookup of index(..., i) does the right thing (in case of a MultiFiltration)
+        persistence_.set(i, cell_boundary(filtration[i], persistence_.field()) |
+                                       ba::filtered([relative](const CellChainEntry& e) { return !relative(e.index()); }) |
+                                       ba::transformed([this,&filtration,i](const CellChainEntry& e)
+                                       { return ChainEntry(e.element(), filtration.index(e.index(), i)); }));
+    };
+
+    auto report = [this,&report_pair](int d, Index i, Index j)
+    {
+        if (this->filtered(i, j))
+        {
+            persistence_.set_skip(i);
+            persistence_.set_skip(j);
+        } else
+            report_pair(d, i, j);
+    };
+
+    // apparent pairs are found from the cells' boundaries, without storing them;
+    // apparent[t] = s for an apparent pair (s,t), s < t
+    std::vector<Index> apparent;
+    if (apparent_pairs_)
+        apparent = dionysus::apparent_pairs<Index>(filtration, [this,&relative](const Cell& c)
+                                                   { return relative(c) || this->above(c.dimension()); });
 
     // sort indices by decreasing dimension
     std::vector<size_t> indices(filtration.size());
@@ -29,10 +60,6 @@ operator()(const Filtration& filtration, const Relative& relative, const ReportP
                      [&filtration](size_t x, size_t y)
                      { return filtration[x].dimension() > filtration[y].dimension(); });
 
-    typedef     typename Filtration::Cell                       Cell;
-    typedef     ChainEntry<Field, Cell>                         CellChainEntry;
-    typedef     ChainEntry<Field, Index>                        ChainEntry;
-
     for(size_t i : indices)
     {
         progress();
@@ -44,19 +71,40 @@ operator()(const Filtration& filtration, const Relative& relative, const ReportP
             continue;
         }
 
+        if (this->above(c.dimension()))
+        {
+            persistence_.set_skip(i);
+            ++this->statistics_.skipped;
+            continue;
+        }
+
         if (persistence_.pair(i) != persistence_.unpaired())
+        {
+            if (persistence_.pair(i) > i)
+            {
+                ++this->statistics_.cleared;
+                persistence_.clear_positive(i);         // clearing
+            }
             continue;
+        }
 
-        // It's fortuitous that indices don't change the filtration. It means
-        // the lookup of index(..., i) does the right thing (in case of a MultiFiltration)
-        persistence_.set(i, c.boundary(persistence_.field()) |
-                                       ba::filtered([relative](const CellChainEntry& e) { return !relative(e.index()); }) |
-                                       ba::transformed([this,&filtration,i](const CellChainEntry& e)
-                                       { return ChainEntry(e.element(), filtration.index(e.index(), i)); }));
+        set_boundary(i);
+
+        Index s = apparent_pairs_ ? apparent[i] : persistence_.unpaired();
+        if (s != persistence_.unpaired() && s < i)
+        {
+            // its boundary is already reduced, with pivot s
+            persistence_.set_pair(s, i);
+            report(c.dimension(), s, i);
+            continue;
+        }
 
         Index pair = persistence_.reduce(i);
+        ++this->statistics_.reduced;
         if (pair != persistence_.unpaired())
-            report_pair(c.dimension(), pair, i);
+            report(c.dimension(), pair, i);
+        else if (this->top(c.dimension()))
+            persistence_.set_skip(i);           // its class is above the maximum dimension
     }
 }
 
@@ -48,17 +48,22 @@ class CohomologyPersistence
                                     field_(std::move(other.field_)),
                                     cmp_(std::move(other.cmp_)),
                                     columns_(std::move(other.columns_)),
+                                    heads_(std::move(other.heads_)),
                                     rows_(std::move(other.rows_))           {}
 
         template<class ChainRange>
         Index                   add(const ChainRange& chain);
 
+        // if birth is false, the cell only kills: if it would give birth, no cocycle is created
         template<class ChainRange>
-        IndexColumn             add(const ChainRange& chain, bool keep_cocycle);
+        IndexColumn             add(const ChainRange& chain, bool keep_cocycle, bool birth = true);
+
+        template<class ChainRange>
+        Index                   kill(const ChainRange& chain)               { return std::get<0>(add(chain, false, false)); }
 
         // TODO: no skip support for now
         bool                    skip(Index) const                   { return false; }
-        void                    add_skip()                          {}
+        void                    add_skip()                          { rows_.emplace_back(); }     // keep the indices aligned
         void                    set_skip(Index, bool flag = true)   {}
 
         const Field&            field() const                               { return field_; }
@@ -73,7 +78,13 @@ class CohomologyPersistence
         Field                   field_;
         Comparison              cmp_;
         Columns                 columns_;
+        std::vector<ColumnsIterator>    heads_;     // column id (the index of its birth) -> column
         std::vector<Row>        rows_;
+
+        // sparse accumulator for the row sums in add(), indexed by column id
+        std::vector<FieldElement>   row_sum_;
+        std::vector<char>           in_sum_;
+        std::vector<Index>          touched_;
 };
 
 
@@ -97,8 +108,8 @@ struct CohomologyPersistence<Field, Index, Cmp>::Entry:
                         Entry(FieldElement e, const Index& i):              // slightly dangerous
                             Parent(e,i)                                     {}
 
-                        Entry(FieldElement e, const Index& i, ColumnsIterator it):
-                            Parent(e,i), column(it)                         {}
+                        Entry(FieldElement e, const Index& i, Index c):
+                            Parent(e,i), column(c)                          {}
 
                         Entry(const Entry& other) = default;
                         Entry(Entry&& other) = default;
@@ -106,7 +117,7 @@ struct CohomologyPersistence<Field, Index, Cmp>::Entry:
     void                unlink()                                            { auto_unlink_hook::unlink(); }
     bool                is_linked()  const                                  {  return auto_unlink_hook::is_linked();  }
 
-    ColumnsIterator     column;     // TODO: I really don't like this overhead
+    Index               column;     // id of the column (see heads_)
 };
 
 }
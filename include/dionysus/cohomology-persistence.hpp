@@ -12,49 +12,87 @@ template<class F, class I, class Cmp>
 template<class ChainRange>
 typename dionysus::CohomologyPersistence<F,I,Cmp>::IndexColumn
 dionysus::CohomologyPersistence<F,I,Cmp>::
-add(const ChainRange& chain, bool keep_cocycle)
+add(const ChainRange& chain, bool keep_cocycle, bool birth)
 {
     auto entry_cmp = [this](const Entry& e1, const Entry& e2) { return this->cmp_(e1.index(), e2.index()); };
-    std::set<Entry,decltype(entry_cmp)>     row_sum(entry_cmp);
+
+    Index n = rows_.size();
+    if (heads_.size() < n + 1)
+    {
+        heads_.resize(n + 1);
+        row_sum_.resize(n + 1, field_.zero());
+        in_sum_.resize(n + 1, false);
+    }
+
+    // the row sum, in a sparse accumulator: a dense array indexed by column id, plus the ids touched
+    touched_.clear();
     for (auto it = std::begin(chain); it != std::end(chain); ++it)
         for (auto& re : rows_[it->index()])
-            dionysus::Chain<decltype(row_sum)>::addto(row_sum, it->element(), Entry(re.element(), re.column->index(), re.column), field_, cmp_);
+        {
+            Index c = re.column;
+            if (!in_sum_[c])
+            {
+                in_sum_[c] = true;
+                touched_.push_back(c);
+            }
+            row_sum_[c] = detail::muladd(field_, row_sum_[c], it->element(), re.element());
+        }
 
-    if (row_sum.empty())        // Birth
+    // drop the cancelled columns, and select the front one in terms of comparison (rows are unsorted)
+    Index  first = unpaired();
+    size_t k     = 0;
+    for (Index c : touched_)
     {
-        columns_.emplace_back(rows_.size());
-        auto before_end = columns_.end();
-           --before_end;
-        columns_.back().chain.push_back(Entry(field_.id(), rows_.size(), before_end));
+        in_sum_[c] = false;
+        if (field_.is_zero(row_sum_[c]))
+        {
+            row_sum_[c] = field_.zero();
+            continue;
+        }
+        touched_[k++] = c;
+        if (first == unpaired() || cmp_(first, c))
+            first = c;
+    }
+    touched_.resize(k);
+
+    if (touched_.empty() && !birth)
+    {
+        rows_.emplace_back();
+        return std::make_tuple(unpaired(), Column());
+    } else if (touched_.empty())        // Birth
+    {
+        columns_.emplace_back(n);
+        heads_[n] = std::prev(columns_.end());
+        columns_.back().chain.push_back(Entry(field_.id(), n, n));
         rows_.emplace_back();
         rows_.back().push_back(columns_.back().chain.front());
         return std::make_tuple(unpaired(), Column());
     } else                      // Death
     {
-        // Select front element in terms of comparison (rows are unsorted)
-        auto it = std::max_element(std::begin(row_sum), std::end(row_sum), entry_cmp);
-
-        Entry first = std::move(*it);
-        row_sum.erase(it);
-
-        for (auto& ce : row_sum)
+        const Column&   first_chain = heads_[first]->chain;
+        FieldElement    first_value = row_sum_[first];
+        for (Index c : touched_)
         {
-            FieldElement ay = field_.neg(field_.div(ce.element(), first.element()));
-            dionysus::Chain<Column>::addto(ce.column->chain, ay, first.column->chain, field_,
-                                 [this](const Entry& e1, const Entry& e2)
-                                 { return this->cmp_(e1.index(), e2.index()); });
-
-            for (auto& x : ce.column->chain)
+            if (c != first)
             {
-                x.column = ce.column;
-                rows_[x.index()].push_back(x);
+                FieldElement ay = field_.neg(field_.div(row_sum_[c], first_value));
+                Column&      cc = heads_[c]->chain;
+                dionysus::Chain<Column>::addto(cc, ay, first_chain, field_, entry_cmp);
+
+                for (auto& x : cc)
+                {
+                    x.column = c;
+                    rows_[x.index()].push_back(x);
+                }
             }
+            row_sum_[c] = field_.zero();
         }
-        Index pair = first.column->index();
+
+        Index pair = first;
         Column cocycle;
         if (keep_cocycle)
-            cocycle = std::move(first.column->chain);
-        columns_.erase(first.column);
+            cocycle = std::move(heads_[first]->chain);
+        columns_.erase(heads_[first]);
         rows_.emplace_back();       // useless row; only present to make indices match
         return std::make_tuple(pair, cocycle);
     }
@@ -0,0 +1,377 @@
+#ifndef DIONYSUS_COMBINATORIAL_SIMPLEX_H
+#define DIONYSUS_COMBINATORIAL_SIMPLEX_H
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <iostream>
+#include <cassert>
+
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <boost/functional/hash.hpp>
+
+#include "chain.h"
+#include "simplex.h"        // for Empty
+
+namespace dionysus
+{
+
+// Pascal's triangle, grown on demand. Entries that don't fit into 64 bits saturate at max().
+class BinomialCoefficients
+{
+    public:
+        typedef     uint64_t                Value;
+
+        static Value    max()                                       { return std::numeric_limits<Value>::max(); }
+
+        Value           operator()(size_t n, size_t k) const        { return table_[n*width_ + k]; }
+        size_t          size() const                                { return width_ == 0 ? 0 : table_.size() / width_; }
+        size_t          width() const                               { return width_; }
+
+        // C(n', k') is available for all n' < n, k' < k
+        bool            reserved(size_t n, size_t k) const          { return n <= size() && k <= width_; }
+
+        // make sure C(n', k') is available for all n' < n, k' < k
+        void            reserve(size_t n, size_t k)
+        {
+            if (reserved(n, k))
+                return;
+
+            n = std::max(n, size());
+            k = std::max(k, width_);
+
+            std::vector<Value> table(n*k, 0);
+            for (size_t i = 0; i < n; ++i)
+            {
+                table[i*k] = 1;
+                for (size_t j = 1; j < k && j <= i; ++j)
+                {
+                    Value a = table[(i-1)*k + j - 1],
+                          b = table[(i-1)*k + j];
+                    table[i*k + j] = (a > max() - b) ? max() : a + b;
+                }
+            }
+            table_.swap(table);
+            width_ = k;
+        }
+
+    private:
+        std::vector<Value>      table_;
+        size_t                  width_ = 0;
+};
+
+namespace detail
+{
+    // Shared by all CombinatorialSimplices. It only grows when new simplices are
+    // encoded (or through CombinatorialSimplex::reserve()), so once the complex is
+    // built, reading it from multiple threads is safe. coboundary() only reads it,
+    // so the table must be reserved for the cofaces up front.
+    inline
+    BinomialCoefficients&   binomials()                             { static BinomialCoefficients b; return b; }
+}
+
+/**
+ * CombinatorialSimplex
+ *
+ * Simplex encoded by its index in the combinatorial number system:
+ * vertices v_0 < ... < v_k are stored as the single number sum_i C(v_i, i+1).
+ * Boundary and coboundary are enumerated arithmetically, without materializing
+ * the vertices, and the cell is a 64-bit code plus the dimension and the data,
+ * so the filtration lookup hashes an integer instead of a vertex array.
+ *
+ * Vertices must be non-negative integers, and the codes must fit into 64 bits
+ * (e.g., up to ~2.6 million vertices for tetrahedra); construction throws
+ * std::overflow_error otherwise. Vertices are enumerated in decreasing order.
+ */
+template<class Vertex_ = unsigned, class T = Empty>
+class CombinatorialSimplex
+{
+    public:
+        typedef         Vertex_                                     Vertex;
+        typedef         T                                           Data;
+        typedef         BinomialCoefficients::Value                 Code;
+
+        class VertexIterator;
+        template<class Field>
+        class BoundaryChainIterator;
+        template<class Field>
+        class CoboundaryChainIterator;
+
+        template<class Field>
+        using BoundaryChainRange    = boost::iterator_range<BoundaryChainIterator<Field>>;
+        template<class Field>
+        using CoboundaryChainRange  = boost::iterator_range<CoboundaryChainIterator<Field>>;
+
+        template<class Field>
+        using Entry = ChainEntry<Field, CombinatorialSimplex>;
+
+    public:
+                        CombinatorialSimplex(const Data& d = Data()):
+                            code_(0), dim_(-1), data_(d)                            {}
+
+                        CombinatorialSimplex(short unsigned dim, Code code, const Data& d = Data()):
+                            code_(code), dim_(dim), data_(d)                        {}
+
+                        CombinatorialSimplex(const std::initializer_list<Vertex>& vertices,
+                                             const Data& d = Data()):
+                            CombinatorialSimplex(vertices.begin(), vertices.end(), d)       {}
+
+        template<class VertexRange>
+                        CombinatorialSimplex(const VertexRange& vertices,
+                                             const Data& d = Data()):
+                            CombinatorialSimplex(std::begin(vertices), std::end(vertices), d) {}
+
+        template<class Iterator>
+                        CombinatorialSimplex(Iterator b, Iterator e, const Data& d = Data()):
+                            data_(d)                                                { encode(std::vector<Vertex>(b, e)); }
+
+        short unsigned  dimension() const                           { return dim_; }
+        Code            code() const                                { return code_; }
+        size_t          size() const                                { return static_cast<short unsigned>(dim_ + 1); }
+
+        VertexIterator  begin() const                               { return VertexIterator(code_, size()); }
+        VertexIterator  end() const                                 { return VertexIterator(); }
+
+        template<class Field>
+        BoundaryChainRange<Field>
+                        boundary(const Field& field) const          { return BoundaryChainRange<Field>(BoundaryChainIterator<Field>(field, *this), BoundaryChainIterator<Field>()); }
+
+        // cofaces in the full simplex on n vertices; the caller filters out those not in the complex.
+        // Requires reserve(n, dimension() + 1) (growing the shared table here would race with other threads).
+        template<class Field>
+        CoboundaryChainRange<Field>
+                        coboundary(const Field& field, Vertex n) const
+        {
+            assert(reserved(n, dim_ + 1));
+            return CoboundaryChainRange<Field>(CoboundaryChainIterator<Field>(field, *this, n), CoboundaryChainIterator<Field>());
+        }
+
+        bool            contains(const Vertex& v) const             { return std::find(begin(), end(), v) != end(); }
+
+        bool            operator==(const CombinatorialSimplex& other) const     { return dim_ == other.dim_ && code_ == other.code_; }
+        bool            operator!=(const CombinatorialSimplex& other) const     { return !operator==(other); }
+        bool            operator<(const CombinatorialSimplex& other) const      { return dim_ < other.dim_ || (dim_ == other.dim_ && code_ < other.code_); }
+        bool            operator>(const CombinatorialSimplex& other) const      { return other < (*this); }
+
+        const Data&     data() const                                { return data_; }
+        Data&           data()                                      { return data_; }
+
+        // Pre-size the shared binomial table: vertices <= n, simplices of dimension <= max_dim
+        static void     reserve(size_t n, size_t max_dim)           { detail::binomials().reserve(n + 1, max_dim + 2); }
+        static bool     reserved(size_t n, size_t max_dim)          { return detail::binomials().reserved(n + 1, max_dim + 2); }
+
+        static Code     binomial(Vertex n, short unsigned k)        { return detail::binomials()(n,k); }
+
+        // largest v in [k-1, top] with C(v,k) <= code
+        static Vertex   max_vertex(Code code, short unsigned k, Vertex top);
+
+        friend
+        std::ostream&   operator<<(std::ostream& out, const CombinatorialSimplex& s)
+        {
+            std::vector<Vertex> vertices(s.begin(), s.end());
+            out << '<';
+            for (auto it = vertices.rbegin(); it != vertices.rend(); ++it)
+                out << (it == vertices.rbegin() ? "" : ",") << *it;
+            out << '>';
+            return out;
+        }
+
+    private:
+        void            encode(std::vector<Vertex> vertices);
+
+    private:
+        Code                code_;
+        short unsigned      dim_;
+        Data                data_;
+};
+
+template<class V, class D>
+size_t hash_value(const CombinatorialSimplex<V,D>& s)               { size_t seed = 0; boost::hash_combine(seed, s.code()); boost::hash_combine(seed, s.dimension()); return seed; }
+
+
+template<class V, class D>
+class CombinatorialSimplex<V,D>::VertexIterator:
+    public boost::iterator_facade<VertexIterator, V, boost::forward_traversal_tag, V>
+{
+    public:
+                    VertexIterator()                                        {}
+                    VertexIterator(Code code, short unsigned k):
+                        code_(code), k_(k)                                  { if (k_ > 0) v_ = max_vertex(code_, k_, detail::binomials().size() - 1); }
+
+    private:
+        friend class    boost::iterator_core_access;
+
+        V           dereference() const                                     { return v_; }
+        bool        equal(const VertexIterator& other) const                { return k_ == other.k_; }
+        void        increment()
+        {
+            code_ -= binomial(v_, k_);
+            if (--k_ > 0)
+                v_ = max_vertex(code_, k_, v_ - 1);
+        }
+
+        Code            code_ = 0;
+        short unsigned  k_    = 0;          // number of vertices left
+        V               v_    = 0;
+};
+
+// Facets of the simplex, from the one omitting the largest vertex to the one omitting the smallest
+template<class V, class D>
+template<class F>
+class CombinatorialSimplex<V,D>::BoundaryChainIterator:
+    public boost::iterator_facade<BoundaryChainIterator<F>, ChainEntry<F, CombinatorialSimplex<V,D>>,
+                                  boost::forward_traversal_tag, ChainEntry<F, CombinatorialSimplex<V,D>>>
+{
+    public:
+        typedef     F                                                       Field;
+        typedef     ChainEntry<F, CombinatorialSimplex<V,D>>                Value;
+
+                    BoundaryChainIterator()                                 {}
+                    BoundaryChainIterator(const Field& field, const CombinatorialSimplex& s):
+                        field_(&field), below_(s.code()), k_(s.dimension() == 0 ? -1 : s.dimension()),
+                        dim_(s.dimension() - 1), top_(detail::binomials().size() - 1)   { find_next(); }
+
+    private:
+        friend class    boost::iterator_core_access;
+
+        Value       dereference() const                                     { return Value((k_ % 2 == 0) ? field_->id() : field_->neg(field_->id()),
+                                                                                           CombinatorialSimplex(dim_, face_)); }
+        bool        equal(const BoundaryChainIterator& other) const         { return k_ == other.k_; }
+        void        increment()                                             { --k_; find_next(); }
+
+        // k_ is the (ascending) position of the omitted vertex
+        void        find_next()
+        {
+            if (k_ < 0)
+                return;
+
+            V   v   = max_vertex(below_, k_ + 1, top_);
+            Code c  = binomial(v, k_ + 1);
+            face_   = above_ + below_ - c;
+            below_ -= c;
+            above_ += binomial(v, k_);
+            top_    = v - 1;
+        }
+
+        const Field*    field_  = nullptr;
+        Code            below_  = 0,
+                        above_  = 0,
+                        face_   = 0;
+        int             k_      = -1;
+        short unsigned  dim_    = 0;
+        V               top_    = 0;
+};
+
+// Cofacets in the full simplex on n vertices, from the one adding the largest vertex to the one adding the smallest
+template<class V, class D>
+template<class F>
+class CombinatorialSimplex<V,D>::CoboundaryChainIterator:
+    public boost::iterator_facade<CoboundaryChainIterator<F>, ChainEntry<F, CombinatorialSimplex<V,D>>,
+                                  boost::forward_traversal_tag, ChainEntry<F, CombinatorialSimplex<V,D>>>
+{
+    public:
+        typedef     F                                                       Field;
+        typedef     ChainEntry<F, CombinatorialSimplex<V,D>>                Value;
+
+                    CoboundaryChainIterator()                               {}
+                    CoboundaryChainIterator(const Field& field, const CombinatorialSimplex& s, V n):
+                        field_(&field), below_(s.code()), v_(static_cast<long>(n) - 1),
+                        k_(s.dimension() + 1), dim_(s.dimension() + 1)      { find_next(); }
+
+    private:
+        friend class    boost::iterator_core_access;
+
+        Value       dereference() const                                     { return Value((k_ % 2 == 0) ? field_->id() : field_->neg(field_->id()),
+                                                                                           CombinatorialSimplex(dim_, coface_)); }
+        bool        equal(const CoboundaryChainIterator& other) const       { return v_ == other.v_; }
+        void        increment()                                             { --v_; find_next(); }
+
+        // k_ is the number of the simplex's vertices below v_, i.e., the position of the inserted vertex
+        void        find_next()
+        {
+            if (v_ < k_)
+            {
+                v_ = -1;
+                return;
+            }
+
+            while (binomial(v_, k_) <= below_)          // v_ is in the simplex; skip it
+            {
+                below_ -= binomial(v_, k_);
+                above_ += binomial(v_, k_ + 1);
+                --v_; --k_;
+            }
+            coface_ = above_ + binomial(v_, k_ + 1) + below_;
+        }
+
+        const Field*    field_  = nullptr;
+        Code            below_  = 0,
+                        above_  = 0,
+                        coface_ = 0;
+        long            v_      = -1;
+        int             k_      = 0;
+        short unsigned  dim_    = 0;
+};
+
+
+/* CombinatorialSimplex */
+template<class V, class D>
+void
+CombinatorialSimplex<V,D>::
+encode(std::vector<Vertex> vertices)
+{
+    std::sort(vertices.begin(), vertices.end());
+    dim_  = vertices.size() - 1;
+    code_ = 0;
+    if (vertices.empty())
+        return;
+
+    reserve(vertices.back(), dim_);
+
+    for (short unsigned i = 0; i < vertices.size(); ++i)
+    {
+        Code c = binomial(vertices[i], i + 1);
+        if (c == BinomialCoefficients::max() || code_ > BinomialCoefficients::max() - c)
+            throw std::overflow_error("Simplex does not fit into the combinatorial number system");
+        code_ += c;
+    }
+}
+
+template<class V, class D>
+V
+CombinatorialSimplex<V,D>::
+max_vertex(Code code, short unsigned k, Vertex top)
+{
+    Vertex bottom = k - 1;
+    if (binomial(top, k) <= code)
+        return top;
+
+    // invariant: C(bottom, k) <= code < C(top, k)
+    while (top - bottom > 1)
+    {
+        Vertex mid = bottom + (top - bottom) / 2;
+        if (binomial(mid, k) <= code)
+            bottom = mid;
+        else
+            top = mid;
+    }
+    return bottom;
+}
+
+}
+
+namespace std
+{
+
+template<class V, class T>
+struct hash<dionysus::CombinatorialSimplex<V,T>>
+{
+    size_t operator()(const dionysus::CombinatorialSimplex<V,T>& s) const   { return hash_value(s); }
+};
+
+} // std
+
+#endif
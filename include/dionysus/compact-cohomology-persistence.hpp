@@ -0,0 +1,165 @@
+template<class F, class I, class Cmp>
+template<class ChainRange>
+typename dionysus::CompactCohomologyPersistence<F,I,Cmp>::Index
+dionysus::CompactCohomologyPersistence<F,I,Cmp>::
+add(const ChainRange& chain)
+{
+    return std::get<0>(add(chain, false));      // return just the index
+}
+
+
+template<class F, class I, class Cmp>
+template<class ChainRange>
+typename dionysus::CompactCohomologyPersistence<F,I,Cmp>::IndexColumn
+dionysus::CompactCohomologyPersistence<F,I,Cmp>::
+add(const ChainRange& chain, bool keep_cocycle, bool birth)
+{
+    auto entry_cmp = [this](const Entry& e1, const Entry& e2) { return this->cmp_(e1.index(), e2.index()); };
+
+    Index n = rows_.size();
+
+    // sum up the rows, dropping their stale entries along the way
+    touched_.clear();
+    for (auto it = std::begin(chain); it != std::end(chain); ++it)
+    {
+        Row& row = rows_[it->index()];
+        compact(row);
+        for (auto& re : row)
+        {
+            Slot s = re.slot;
+            if (!in_sum_[s])
+            {
+                in_sum_[s] = true;
+                touched_.push_back(s);
+            }
+            row_sum_[s] = detail::muladd(field_, row_sum_[s], it->element(), re.element());
+        }
+    }
+
+    // drop the cancelled columns, and select the front one in terms of comparison (rows are unsorted)
+    Slot   first = 0;
+    size_t k     = 0;
+    for (Slot s : touched_)
+    {
+        in_sum_[s] = false;
+        if (field_.is_zero(row_sum_[s]))
+        {
+            row_sum_[s] = field_.zero();
+            continue;
+        }
+        if (k == 0 || cmp_(columns_[first].index(), columns_[s].index()))
+            first = s;
+        touched_[k++] = s;
+    }
+    touched_.resize(k);
+
+    if (touched_.empty() && !birth)
+    {
+        rows_.emplace_back();
+        return std::make_tuple(unpaired(), Column());
+    } else if (touched_.empty())        // Birth
+    {
+        rows_.emplace_back();
+        Slot s = new_column(n);
+        columns_[s].chain.emplace_back(field_.id(), n);
+        link(s);
+        return std::make_tuple(unpaired(), Column());
+    } else                      // Death
+    {
+        const Column&   first_chain = columns_[first].chain;
+        FieldElement    first_value = row_sum_[first];
+        for (Slot s : touched_)
+        {
+            if (s != first)
+            {
+                FieldElement ay = field_.neg(field_.div(row_sum_[s], first_value));
+                unlink(s);
+                dionysus::Chain<Column>::addto(columns_[s].chain, ay, first_chain, field_, entry_cmp);
+                link(s);
+            }
+            row_sum_[s] = field_.zero();
+        }
+
+        Index pair = columns_[first].index();
+        Column cocycle;
+        unlink(first);
+        if (keep_cocycle)
+            cocycle = std::move(columns_[first].chain);
+        columns_[first].chain.clear();
+        free_.push_back(first);
+        rows_.emplace_back();       // useless row; only present to make indices match
+
+        if (stale_ > valid_)
+            compact();
+
+        return std::make_tuple(pair, cocycle);
+    }
+}
+
+template<class F, class I, class Cmp>
+typename dionysus::CompactCohomologyPersistence<F,I,Cmp>::Slot
+dionysus::CompactCohomologyPersistence<F,I,Cmp>::
+new_column(Index i)
+{
+    if (!free_.empty())
+    {
+        Slot s = free_.back();
+        free_.pop_back();
+        columns_[s].index_ = i;
+        return s;
+    }
+
+    columns_.emplace_back(i);
+    row_sum_.push_back(field_.zero());
+    in_sum_.push_back(false);
+    return columns_.size() - 1;
+}
+
+template<class F, class I, class Cmp>
+void
+dionysus::CompactCohomologyPersistence<F,I,Cmp>::
+link(Slot s)
+{
+    const ColumnHead& c = columns_[s];
+    for (auto& e : c.chain)
+        rows_[e.index()].emplace_back(e.element(), s, c.stamp);
+    valid_ += c.chain.size();
+}
+
+template<class F, class I, class Cmp>
+void
+dionysus::CompactCohomologyPersistence<F,I,Cmp>::
+unlink(Slot s)
+{
+    ColumnHead& c = columns_[s];
+    ++c.stamp;                  // a stale entry would have to outlive 2^32 changes of its column to pass for valid
+    valid_ -= c.chain.size();
+    stale_ += c.chain.size();
+}
+
+template<class F, class I, class Cmp>
+void
+dionysus::CompactCohomologyPersistence<F,I,Cmp>::
+compact(Row& row)
+{
+    size_t k = 0;
+    for (auto& re : row)
+        if (valid(re))
+            row[k++] = re;
+    stale_ -= row.size() - k;
+    row.erase(row.begin() + k, row.end());
+}
+
+template<class F, class I, class Cmp>
+void
+dionysus::CompactCohomologyPersistence<F,I,Cmp>::
+compact()
+{
+    ++compactions_;
+    for (auto& row : rows_)
+    {
+        compact(row);
+        if (row.capacity() > 2*row.size())
+            row.shrink_to_fit();
+    }
+}
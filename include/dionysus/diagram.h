@@ -66,14 +66,16 @@ namespace detail
     };
 }
 
+// Diagrams of the first n cells: the prefix of a progressive reduction
+// (ReducedMatrix::reduce_upto()); the classes alive at n are infinite.
 template<class ReducedMatrix, class Filtration, class GetValue, class GetData>
 typename detail::Diagrams<ReducedMatrix, Filtration, GetValue, GetData>::type
-init_diagrams(const ReducedMatrix& m, const Filtration& f, const GetValue& get_value, const GetData& get_data)
+init_diagrams(const ReducedMatrix& m, const Filtration& f, const GetValue& get_value, const GetData& get_data, size_t n)
 {
     using Result  = typename detail::Diagrams<ReducedMatrix, Filtration, GetValue, GetData>::type;
 
     Result diagrams;
-    for (typename ReducedMatrix::Index i = 0; i < m.size(); ++i)
+    for (typename ReducedMatrix::Index i = 0; i < n; ++i)
     {
         if (m.skip(i))
             continue;
@@ -85,7 +87,7 @@ init_diagrams(const ReducedMatrix& m, const Filtration& f, const GetValue& get_v
             diagrams.emplace_back();
 
         auto pair = m.pair(i);
-        if (pair == m.unpaired())
+        if (pair == m.unpaired() || pair >= n)
         {
             auto  birth = get_value(s,i);
             using Value = decltype(birth);
@@ -112,6 +114,13 @@ init_diagrams(const ReducedMatrix& m, const Filtration& f, const GetValue& get_v
     return diagrams;
 }
 
+template<class ReducedMatrix, class Filtration, class GetValue, class GetData>
+typename detail::Diagrams<ReducedMatrix, Filtration, GetValue, GetData>::type
+init_diagrams(const ReducedMatrix& m, const Filtration& f, const GetValue& get_value, const GetData& get_data)
+{
+    return init_diagrams(m, f, get_value, get_data, m.size());
+}
+
 }
 
 #endif
@@ -0,0 +1,122 @@
+#ifndef DIONYSUS_MULTI_ZP_H
+#define DIONYSUS_MULTI_ZP_H
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+
+#include "zp.h"
+
+namespace dionysus
+{
+
+// K fields Z/pZ side by side: an element carries one residue per prime (a lane),
+// and the operations apply lane by lane, in loops over fixed-size arrays. Products
+// are reduced by Barrett reduction, with a precomputed constant per lane, so the
+// loops have no division. For short residues (the default), Wide is 32 bits and
+// the loops vectorize; with wider residues, the reduction needs the high half of
+// a 64-bit product, which SIMD units don't provide, and the loops stay scalar.
+// This is not a field, since an element can vanish in some lanes only;
+// MultiPrimePersistence uses it as long as the lanes agree.
+template<unsigned K, typename Element_ = short>
+class MultiZpField
+{
+    public:
+        typedef         Element_                            BaseElement;
+        typedef         std::array<BaseElement, K>          Element;
+        typedef         std::array<BaseElement, K>          Primes;
+        typedef         ZpField<BaseElement>                Zp;
+
+        // products of two residues fit into Wide
+        typedef         typename std::conditional<sizeof(BaseElement) <= 2, uint32_t, uint64_t>::type     Wide;
+
+        static constexpr unsigned   lanes = K;
+
+                        MultiZpField(const Primes& primes);
+
+        Element         id()  const                         { Element x; x.fill(1); return x; }
+        Element         zero()  const                       { Element x; x.fill(0); return x; }
+        Element         init(int a) const                   { Element x; for (unsigned k = 0; k < K; ++k) x[k] = lanes_[k].init(a); return x; }
+
+        Element         neg(const Element& a) const         { Element x; for (unsigned k = 0; k < K; ++k) x[k] = a[k] == 0 ? 0 : primes_[k] - a[k]; return x; }
+        Element         add(const Element& a, const Element& b) const;
+
+        // lanes where a is zero stay zero
+        Element         inv(const Element& a) const         { Element x; for (unsigned k = 0; k < K; ++k) x[k] = lanes_[k].inv(a[k]); return x; }
+        Element         mul(const Element& a, const Element& b) const;
+        Element         div(const Element& a, const Element& b) const     { return mul(a, inv(b)); }
+
+        Element         muladd(const Element& x, const Element& a, const Element& y) const;
+
+        // zero in every lane
+        bool            is_zero(const Element& a) const     { bool z = true; for (unsigned k = 0; k < K; ++k) z &= a[k] == 0; return z; }
+        // non-zero in every lane
+        bool            is_unit(const Element& a) const     { bool u = true; for (unsigned k = 0; k < K; ++k) u &= a[k] != 0; return u; }
+
+        const Primes&   primes() const                      { return primes_; }
+        const Zp&       lane(unsigned k) const              { return lanes_[k]; }
+
+    private:
+        typedef         std::array<Wide, K>                 Wides;
+
+    private:
+        Primes                  primes_;
+        Wides                   wide_primes_;
+        Wides                   barrett_;           // floor(max(Wide)/p) for each lane
+        std::vector<Zp>         lanes_;
+};
+
+template<unsigned K, class E>
+MultiZpField<K,E>::
+MultiZpField(const Primes& primes):
+    primes_(primes)
+{
+    lanes_.reserve(K);
+    for (unsigned k = 0; k < K; ++k)
+    {
+        wide_primes_[k] = primes_[k];
+        barrett_[k]     = ~Wide(0) / Wide(primes_[k]);
+        lanes_.emplace_back(primes_[k]);
+    }
+}
+
+template<unsigned K, class E>
+typename MultiZpField<K,E>::Element
+MultiZpField<K,E>::
+add(const Element& a, const Element& b) const
+{
+    Element x;
+    for (unsigned k = 0; k < K; ++k)
+    {
+        Wide s = Wide(a[k]) + Wide(b[k]);
+        x[k] = s >= Wide(primes_[k]) ? s - primes_[k] : s;
+    }
+    return x;
+}
+
+template<unsigned K, class E>
+typename MultiZpField<K,E>::Element
+MultiZpField<K,E>::
+mul(const Element& a, const Element& b) const
+{
+    Element x;
+    for (unsigned k = 0; k < K; ++k)
+        x[k] = detail::barrett_reduce(Wide(a[k]) * Wide(b[k]), wide_primes_[k], barrett_[k]);
+    return x;
+}
+
+template<unsigned K, class E>
+typename MultiZpField<K,E>::Element
+MultiZpField<K,E>::
+muladd(const Element& x, const Element& a, const Element& y) const
+{
+    Element r;
+    for (unsigned k = 0; k < K; ++k)
+        r[k] = detail::barrett_reduce(Wide(x[k]) + Wide(a[k]) * Wide(y[k]), wide_primes_[k], barrett_[k]);
+    return r;
+}
+
+}
+
+#endif
@@ -2,43 +2,84 @@
 #define DIONYSUS_Q_H
 
 #include <iostream>
+#include <memory>
+#include <limits>
+#include <cassert>
 
-// TODO: eventually need to be able to adaptively switch to arbitrary precision arithmetic
+#include <boost/multiprecision/cpp_int.hpp>
 
 namespace dionysus
 {
 
+// Rational numbers. Numerators and denominators are BaseElements, and the
+// arithmetic on them checks for overflow: a result that doesn't fit is promoted
+// to arbitrary precision (big), and demoted back once it fits again, so only the
+// offending entries pay for it. Elements are kept normalized (reduced, with a
+// positive denominator), so that each value has a unique representation.
 template<typename Element_ = long>
 class Q
 {
     public:
         using           BaseElement = Element_;
+        using           BigInteger  = boost::multiprecision::cpp_int;
+
+        struct BigElement
+        {
+            BigInteger  numerator, denominator;
+        };
+
         struct Element
         {
-            BaseElement numerator, denominator;
+            BaseElement                         numerator, denominator;
+            std::shared_ptr<const BigElement>   big {};     // set iff the value doesn't fit into BaseElements
 
-            bool        operator==(Element o) const                     { return numerator == o.numerator && denominator == o.denominator; }
-            bool        operator!=(Element o) const                     { return !((*this) == o); }
+            bool        is_big() const                                  { return static_cast<bool>(big); }
+
+            bool        operator==(const Element& o) const
+            {
+                if (big || o.big)
+                    return big && o.big && big->numerator == o.big->numerator && big->denominator == o.big->denominator;
+                return numerator == o.numerator && denominator == o.denominator;
+            }
+            bool        operator!=(const Element& o) const              { return !((*this) == o); }
 
             friend
-            std::ostream&   operator<<(std::ostream& out, Element e)    { out << e.numerator << '/' << e.denominator; return out; }
+            std::ostream&   operator<<(std::ostream& out, const Element& e)
+            {
+                if (e.big)
+                    out << e.big->numerator << '/' << e.big->denominator;
+                else
+                    out << e.numerator << '/' << e.denominator;
+                return out;
+            }
         };
 
         Element         id()  const                         { return { 1,1 }; }
         Element         zero()  const                       { return { 0,1 }; }
-        Element         init(BaseElement a) const           { return { a,1 }; }
+        Element         init(BaseElement a) const           { if (a == min()) return make(a, 1); return { a,1 }; }
 
-        Element         neg(Element a) const                { return { -a.numerator, a.denominator }; }
-        Element         add(Element a, Element b) const     { Element x { a.numerator*b.denominator + b.numerator*a.denominator, a.denominator*b.denominator }; normalize(x); return x; }
+        Element         neg(const Element& a) const;
+        Element         add(const Element& a, const Element& b) const;
 
-        Element         inv(Element a) const                { return { a.denominator, a.numerator }; }
-        Element         mul(Element a, Element b) const     { Element x { a.numerator*b.numerator, a.denominator*b.denominator }; normalize(x); return x; }
-        Element         div(Element a, Element b) const     { return mul(a, inv(b)); }
+        Element         inv(const Element& a) const;
+        Element         mul(const Element& a, const Element& b) const;
+        Element         div(const Element& a, const Element& b) const    { return mul(a, inv(b)); }
 
-        bool            is_zero(Element a) const            { return a.numerator == 0; }
+        bool            is_zero(const Element& a) const     { return !a.big && a.numerator == 0; }
 
-        BaseElement     numerator(const Element& x) const   { return x.numerator; }
-        BaseElement     denominator(const Element& x) const { return x.denominator; }
+        // x must not be big
+        BaseElement     numerator(const Element& x) const   { assert(!x.big); return x.numerator; }
+        BaseElement     denominator(const Element& x) const { assert(!x.big); return x.denominator; }
+
+        BigInteger      big_numerator(const Element& x) const   { return x.big ? x.big->numerator   : BigInteger(x.numerator); }
+        BigInteger      big_denominator(const Element& x) const { return x.big ? x.big->denominator : BigInteger(x.denominator); }
+
+        // residues in [0,p)
+        BaseElement     numerator_mod(const Element& x, BaseElement p) const    { return x.big ? mod(x.big->numerator, p)   : mod(x.numerator, p); }
+        BaseElement     denominator_mod(const Element& x, BaseElement p) const  { return x.big ? mod(x.big->denominator, p) : mod(x.denominator, p); }
+
+        // reduced element equal to n/d, big only if necessary
+        static Element  make(BigInteger n, BigInteger d);
 
         static void     normalize(Element& x)
         {
@@ -55,9 +96,111 @@ class Q
         static BaseElement  abs(BaseElement x)              { if (x < 0) return -x; return x; }
         static BaseElement  gcd(BaseElement a, BaseElement b)   { if (b < a) return gcd(b,a); while (a != 0) { b %= a; std::swap(a,b); } return b; }
 
-        static bool     is_prime(BaseElement x)             { return false; }       // Ok, since is_prime is only used as a shortcut
+        template<class Integer>
+        static bool     is_prime(const Integer& x)          { return false; }       // Ok, since is_prime is only used as a shortcut
+
+    private:
+        // the smallest BaseElement is never stored, so that negation and abs() can't overflow
+        static BaseElement  min()                           { return std::numeric_limits<BaseElement>::min(); }
+        static bool         fits(const BigInteger& x)       { return x > min() && x <= std::numeric_limits<BaseElement>::max(); }
+
+        static BaseElement  mod(BaseElement x, BaseElement p)       { x %= p; return x < 0 ? x + p : x; }
+        static BaseElement  mod(const BigInteger& x, BaseElement p) { BigInteger r = x % p; if (r < 0) r += p; return r.template convert_to<BaseElement>(); }
 };
 
+template<class E>
+typename Q<E>::Element
+Q<E>::
+make(BigInteger n, BigInteger d)
+{
+    BigInteger q = boost::multiprecision::gcd(n, d);
+    if (q != 0 && q != 1)
+    {
+        n /= q;
+        d /= q;
+    }
+    if (d < 0)
+    {
+        n = -n;
+        d = -d;
+    }
+
+    if (fits(n) && fits(d))
+        return { n.template convert_to<BaseElement>(), d.template convert_to<BaseElement>() };
+
+    Element x { 0, 0 };
+    x.big = std::make_shared<const BigElement>(BigElement { std::move(n), std::move(d) });
+    return x;
+}
+
+template<class E>
+typename Q<E>::Element
+Q<E>::
+neg(const Element& a) const
+{
+    if (!a.big)
+        return { -a.numerator, a.denominator };
+    return make(-a.big->numerator, a.big->denominator);
+}
+
+template<class E>
+typename Q<E>::Element
+Q<E>::
+add(const Element& a, const Element& b) const
+{
+    if (!a.big && !b.big)
+    {
+        BaseElement x, y;
+        Element     r;
+        if (!__builtin_mul_overflow(a.numerator, b.denominator, &x) &&
+            !__builtin_mul_overflow(b.numerator, a.denominator, &y) &&
+            !__builtin_add_overflow(x, y, &r.numerator) &&
+            !__builtin_mul_overflow(a.denominator, b.denominator, &r.denominator) &&
+            r.numerator != min() && r.denominator != min())
+        {
+            normalize(r);
+            return r;
+        }
+    }
+
+    return make(big_numerator(a)*big_denominator(b) + big_numerator(b)*big_denominator(a),
+                big_denominator(a)*big_denominator(b));
+}
+
+template<class E>
+typename Q<E>::Element
+Q<E>::
+inv(const Element& a) const
+{
+    if (!a.big)
+    {
+        if (a.numerator < 0)
+            return { -a.denominator, -a.numerator };
+        return { a.denominator, a.numerator };
+    }
+    return make(a.big->denominator, a.big->numerator);
+}
+
+template<class E>
+typename Q<E>::Element
+Q<E>::
+mul(const Element& a, const Element& b) const
+{
+    if (!a.big && !b.big)
+    {
+        Element r;
+        if (!__builtin_mul_overflow(a.numerator,   b.numerator,   &r.numerator) &&
+            !__builtin_mul_overflow(a.denominator, b.denominator, &r.denominator) &&
+            r.numerator != min() && r.denominator != min())
+        {
+            normalize(r);
+            return r;
+        }
+    }
+
+    return make(big_numerator(a)*big_numerator(b), big_denominator(a)*big_denominator(b));
+}
+
 }
 
 #endif
@@ -2,15 +2,67 @@
 #define DIONYSUS_ZP_H
 
 #include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <type_traits>
 
 namespace dionysus
 {
 
+namespace detail
+{
+    // Table of inverses mod p, built in O(p) from inv(i) = -(p/i) * inv(p % i);
+    // the tables are immutable, so they are shared by all fields over the same prime.
+    template<class Element>
+    std::shared_ptr<const std::vector<Element>>
+    zp_inverses(Element p);
+
+    // high half of the product x*y
+    inline uint32_t     mulhi(uint32_t x, uint32_t y)       { return uint32_t((uint64_t(x) * y) >> 32); }
+    inline uint64_t     mulhi(uint64_t x, uint64_t y)
+    {
+#if defined(__SIZEOF_INT128__)
+        return uint64_t(((unsigned __int128) x * y) >> 64);
+#else
+        uint64_t x0 = uint32_t(x), x1 = x >> 32,
+                 y0 = uint32_t(y), y1 = y >> 32;
+        uint64_t mid = x1*y0 + (x0*y0 >> 32);
+        return x1*y1 + (mid >> 32) + ((uint32_t(mid) + x0*y1) >> 32);
+#endif
+    }
+
+    // Barrett reduction: x mod p, given m = floor(max(Wide)/p). The quotient
+    // estimate mulhi(x,m) is off by at most 2, so two conditional subtractions
+    // finish the job, without a division.
+    template<class Wide>
+    Wide                barrett_reduce(Wide x, Wide p, Wide m)
+    {
+        Wide r = x - mulhi(x, m) * p;
+        r = r >= p ? r - p : r;
+        return r >= p ? r - p : r;
+    }
+}
+
+// Arithmetic mod p. Sums are reduced by a conditional subtraction, products by
+// Barrett reduction (see reduce()), and x + a*y is computed in 64 bits with a single
+// reduction (see muladd()). The operations accept any representative (e.g., -1, as
+// stored by the Python bindings' boundary()): they normalize their operands first,
+// which costs a comparison for those already in [0,p). Their results are in [0,p).
+//
+// Lazy arithmetic: lazy_mul() returns the unreduced product, and up to lazy_bound()
+// of them can be summed in an Accumulator before it has to be reduced; LazyHeapColumn
+// (see reduction.h) uses this to reduce a working column only when it checks for zero.
 template<typename Element_ = short>
 class ZpField
 {
     public:
         typedef         Element_                            Element;
+        typedef         typename std::make_unsigned<Element>::type  Unsigned;
+        typedef         uint64_t                            Wide;
+        // sums of products, for lazy arithmetic; as narrow as possible, to keep LazyHeapColumn compact
+        typedef         typename std::conditional<sizeof(Element) <= 2, uint32_t, uint64_t>::type     Accumulator;
 
                         ZpField(Element p);
                         ZpField(const ZpField& other)       = default;
@@ -20,34 +72,71 @@ class ZpField
         Element         zero()  const                       { return 0; }
         Element         init(int a) const                   { return (a % p_ + p_) % p_; }
 
-        Element         neg(Element a) const                { return p_ - a; }
-        Element         add(Element a, Element b) const     { return (a+b) % p_; }
+        Element         neg(Element a) const                { a = normalize(a); return a == 0 ? 0 : p_ - a; }
+        Element         add(Element a, Element b) const     { Wide s = wide(a) + wide(b); return s >= Wide(p_) ? s - p_ : s; }
 
-        Element         inv(Element a) const                { while (a < 0) a += p_; return inverses_[a]; }
-        Element         mul(Element a, Element b) const     { return (a*b) % p_; }
+        Element         inv(Element a) const                { return (*inverses_)[normalize(a)]; }
+        Element         mul(Element a, Element b) const     { return reduce(wide(a) * wide(b)); }
         Element         div(Element a, Element b) const     { return mul(a, inv(b)); }
 
-        bool            is_zero(Element a) const            { return (a % p_) == 0; }
+        // x + a*y with a single reduction (used by Chain::addto())
+        Element         muladd(Element x, Element a, Element y) const   { return reduce(wide(x) + wide(a) * wide(y)); }
+
+        bool            is_zero(Element a) const            { return a == 0 || normalize(a) == 0; }
 
         Element         prime() const                       { return p_; }
 
+        // the representative of a in [0,p)
+        Element         normalize(Element a) const          { return Unsigned(a) < Unsigned(p_) ? a : (a % p_ + p_) % p_; }
+
+        // x mod p, for any x
+        Element         reduce(Wide x) const                { return detail::barrett_reduce(x, Wide(p_), barrett_); }
+
+        Accumulator     lazy_mul(Element a, Element y) const    { return Accumulator(normalize(a)) * Accumulator(normalize(y)); }
+        // number of terms, each at most (p-1)^2 (e.g., a product or an element), that fit into an Accumulator
+        Accumulator     lazy_bound() const                  { return lazy_bound_; }
+
+    private:
+        Wide            wide(Element a) const               { return Wide(normalize(a)); }
+
     private:
-        Element                 p_;
-        std::vector<Element>    inverses_;
+        Element                                         p_;
+        Wide                                            barrett_;       // floor(max(Wide)/p)
+        Accumulator                                     lazy_bound_;
+        std::shared_ptr<const std::vector<Element>>     inverses_;
 };
 
 template<class E>
 ZpField<E>::
 ZpField(Element p):
-    p_(p), inverses_(p_)
+    p_(p),
+    barrett_(p > 0 ? ~Wide(0) / Wide(p) : 0),
+    lazy_bound_(p > 1 ? Accumulator(~Accumulator(0) / (Wide(p - 1) * Wide(p - 1))) : ~Accumulator(0)),
+    inverses_(detail::zp_inverses(p))
+{}
+
+template<class Element>
+std::shared_ptr<const std::vector<Element>>
+dionysus::detail::
+zp_inverses(Element p)
 {
-    for (Element i = 1; i < p_; ++i)
-        for (Element j = 1; j < p_; ++j)
-            if (mul(i,j) == 1)
-            {
-                inverses_[i] = j;
-                break;
-            }
+    typedef     std::shared_ptr<const std::vector<Element>>     Table;
+
+    static std::mutex                   mutex;
+    static std::map<Element, Table>     cache;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Table& table = cache[p];
+    if (!table)
+    {
+        std::vector<Element> inverses(p > 0 ? p : 0);
+        if (p > 1)
+            inverses[1] = 1;
+        for (Element i = 2; i < p; ++i)
+            inverses[i] = p - Element(uint64_t(p / i) * uint64_t(inverses[p % i]) % uint64_t(p));
+        table = std::make_shared<const std::vector<Element>>(std::move(inverses));
+    }
+    return table;
 }
 
 }
@@ -8,6 +8,7 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/random_access_index.hpp>
+#include <boost/functional/hash.hpp>
 
 namespace b   = boost;
 namespace bmi = boost::multi_index;
@@ -61,6 +62,15 @@ class Filtration
         size_t              index(const Cell& s, size_t) const;
         bool                contains(const Cell& s) const                       { return cells_.find(s) != cells_.end(); }
 
+        // Heterogeneous lookup: CellView must hash and compare equal to the cell
+        // it represents (e.g., Simplex::Face), but need not be converted into one
+        template<class CellView>
+        OrderConstIterator  iterator(const CellView& s) const                   { return bmi::project<order>(cells_, cells_.find(s, b::hash<CellView>(), CompatibleEqual())); }
+        template<class CellView>
+        size_t              index(const CellView& s, size_t) const;
+        template<class CellView>
+        bool                contains(const CellView& s) const                   { return cells_.find(s, b::hash<CellView>(), CompatibleEqual()) != cells_.end(); }
+
         void                push_back(const Cell& s)                            { cells_.template get<order>().push_back(s); }
         void                push_back(Cell&& s)                                 { cells_.template get<order>().push_back(s); }
 
@@ -84,6 +94,16 @@ class Filtration
         Cell&               back()                                              { return const_cast<Cell&>(cells_.template get<order>().back()); }
         const Cell&         back() const                                        { return cells_.template get<order>().back(); }
 
+    private:
+        struct CompatibleEqual
+        {
+            template<class CellView>
+            bool            operator()(const CellView& x, const Cell& y) const  { return x == y; }
+        };
+
+        template<class CellView>
+        size_t              index_impl(const CellView& s) const;
+
     private:
         Container           cells_;
 };
@@ -94,6 +114,24 @@ template<class C, class CLI, bool checked_index>
 size_t
 dionysus::Filtration<C,CLI,checked_index>::
 index(const Cell& s, size_t) const
+{
+    return index_impl(s);
+}
+
+template<class C, class CLI, bool checked_index>
+template<class CellView>
+size_t
+dionysus::Filtration<C,CLI,checked_index>::
+index(const CellView& s, size_t) const
+{
+    return index_impl(s);
+}
+
+template<class C, class CLI, bool checked_index>
+template<class CellView>
+size_t
+dionysus::Filtration<C,CLI,checked_index>::
+index_impl(const CellView& s) const
 {
     auto it = iterator(s);
     if (checked_index && it == end())
@@ -0,0 +1,303 @@
+#ifndef DIONYSUS_FLAT_FILTRATION_H
+#define DIONYSUS_FLAT_FILTRATION_H
+
+#include <vector>
+#include <sstream>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/functional/hash.hpp>
+
+namespace b   = boost;
+
+namespace dionysus
+{
+
+// FlatFiltration has the same interface as Filtration, but stores the cells
+// contiguously, in order, and looks them up through an open-addressing hash
+// table of indices (linear probing, with the cell hashes cached in the slots).
+// Bulk construction (from a range, or through assign()) builds the table once,
+// after the cells are in place. As in Filtration, the range constructors keep
+// the cells in the order given; only assign(cells, cmp) sorts them first.
+// sort() rebuilds the table once; rearrange() only remaps its indices.
+// As in Filtration, duplicate cells are ignored.
+template<class Cell_,
+         bool  checked_index = false>
+class FlatFiltration
+{
+    public:
+        typedef             Cell_                                               Cell;
+        typedef             std::vector<Cell>                                   Container;
+        typedef             typename Container::value_type                      value_type;
+
+        // cells are keys, so the iterators are constant, as in Filtration
+        typedef             typename Container::const_iterator                  OrderConstIterator;
+        typedef             OrderConstIterator                                  OrderIterator;
+
+    public:
+                            FlatFiltration()                                    = default;
+                            FlatFiltration(FlatFiltration&& other)              = default;
+        FlatFiltration&     operator=(FlatFiltration&& other)                   = default;
+
+                            FlatFiltration(const std::initializer_list<Cell>& cells):
+                                FlatFiltration(std::begin(cells), std::end(cells))  {}
+
+        template<class Iterator>
+                            FlatFiltration(Iterator bg, Iterator end)           { assign(Container(bg, end)); }
+
+        template<class CellRange>
+                            FlatFiltration(const CellRange& cells):
+                                FlatFiltration(std::begin(cells), std::end(cells))  {}
+
+        // Bulk construction: take over the cells, (optionally) sort them, and index them once
+        template<class Cmp>
+        void                assign(Container&& cells, const Cmp& cmp)           { cells_ = std::move(cells); sort(cmp); }
+        void                assign(Container&& cells)                           { cells_ = std::move(cells); build_index(); }
+
+        void                reserve(size_t n)                                   { cells_.reserve(n); if (2*n > slots_.size()) grow(2*n); }
+
+        // Lookup
+        const Cell&         operator[](size_t i) const                          { return cells_[i]; }
+        OrderConstIterator  iterator(const Cell& s) const                       { return begin() + find(s); }
+        size_t              index(const Cell& s, size_t) const                  { return index_impl(s); }
+        bool                contains(const Cell& s) const                       { return find(s) != size(); }
+
+        // Heterogeneous lookup: CellView must hash and compare equal to the cell
+        // it represents (e.g., Simplex::Face), but need not be converted into one
+        template<class CellView>
+        OrderConstIterator  iterator(const CellView& s) const                   { return begin() + find(s); }
+        template<class CellView>
+        size_t              index(const CellView& s, size_t) const              { return index_impl(s); }
+        template<class CellView>
+        bool                contains(const CellView& s) const                   { return find(s) != size(); }
+
+        void                push_back(const Cell& s)                            { emplace_back(s); }
+        void                push_back(Cell&& s)                                 { emplace_back(std::move(s)); }
+
+        void                replace(size_t i, const Cell& s);
+
+        template<class... Args>
+        void                emplace_back(Args&&... args);
+
+        template<class Cmp = std::less<Cell>>
+        void                sort(const Cmp& cmp = Cmp())                        { std::stable_sort(cells_.begin(), cells_.end(), cmp); build_index(); }
+
+        void                rearrange(const std::vector<size_t>& indices);
+
+        OrderConstIterator  begin() const                                       { return cells_.begin(); }
+        OrderConstIterator  end() const                                         { return cells_.end(); }
+        size_t              size() const                                        { return cells_.size(); }
+        void                clear()                                             { Container().swap(cells_); std::vector<Slot>().swap(slots_); }
+
+        Cell&               back()                                              { return cells_.back(); }
+        const Cell&         back() const                                        { return cells_.back(); }
+
+    private:
+        struct Slot
+        {
+            size_t          hash;
+            size_t          index;
+        };
+
+        static constexpr size_t empty()                                         { return std::numeric_limits<size_t>::max(); }
+
+        size_t              mask() const                                        { return slots_.size() - 1; }
+
+        template<class CellView>
+        static size_t       hash(const CellView& s)                             { return b::hash<CellView>()(s); }
+
+        // slot holding s, or the empty slot where it would go
+        template<class CellView>
+        size_t              probe(const CellView& s, size_t h) const;
+
+        template<class CellView>
+        size_t              find(const CellView& s) const;
+
+        template<class CellView>
+        size_t              index_impl(const CellView& s) const;
+
+        void                build_index();
+        void                grow(size_t n);
+        void                erase_slot(size_t i);
+
+    private:
+        Container           cells_;
+        std::vector<Slot>   slots_;             // size is a power of 2, at most half full
+};
+
+}
+
+template<class C, bool checked_index>
+template<class CellView>
+size_t
+dionysus::FlatFiltration<C,checked_index>::
+probe(const CellView& s, size_t h) const
+{
+    size_t i = h & mask();
+    while (slots_[i].index != empty() && !(slots_[i].hash == h && s == cells_[slots_[i].index]))
+        i = (i + 1) & mask();
+    return i;
+}
+
+template<class C, bool checked_index>
+template<class CellView>
+size_t
+dionysus::FlatFiltration<C,checked_index>::
+find(const CellView& s) const
+{
+    if (slots_.empty())
+        return size();
+
+    size_t i = slots_[probe(s, hash(s))].index;
+    return i == empty() ? size() : i;
+}
+
+template<class C, bool checked_index>
+template<class CellView>
+size_t
+dionysus::FlatFiltration<C,checked_index>::
+index_impl(const CellView& s) const
+{
+    size_t i = find(s);
+    if (checked_index && i == size())
+    {
+        std::ostringstream oss;
+        oss << "Trying to access non-existent cell: " << s;
+        throw std::runtime_error(oss.str());
+    }
+    return i;
+}
+
+template<class C, bool checked_index>
+template<class... Args>
+void
+dionysus::FlatFiltration<C,checked_index>::
+emplace_back(Args&&... args)
+{
+    if (2*(size() + 1) > slots_.size())
+        grow(2*(size() + 1));
+
+    cells_.emplace_back(std::forward<Args>(args)...);
+
+    size_t h = hash(cells_.back());
+    size_t i = probe(cells_.back(), h);
+    if (slots_[i].index != empty())     // duplicate
+    {
+        cells_.pop_back();
+        return;
+    }
+    slots_[i] = Slot { h, size() - 1 };
+}
+
+template<class C, bool checked_index>
+void
+dionysus::FlatFiltration<C,checked_index>::
+replace(size_t i, const Cell& s)
+{
+    size_t h = hash(s);
+    size_t j = probe(s, h);
+    if (slots_[j].index == i)           // same cell, new data
+    {
+        cells_[i] = s;
+        return;
+    }
+    if (slots_[j].index != empty())     // s is already in the filtration
+        return;
+
+    erase_slot(probe(cells_[i], hash(cells_[i])));
+    cells_[i] = s;
+    slots_[probe(s, h)] = Slot { h, i };
+}
+
+template<class C, bool checked_index>
+void
+dionysus::FlatFiltration<C,checked_index>::
+rearrange(const std::vector<size_t>& indices)
+{
+    Container cells; cells.reserve(indices.size());
+    std::vector<size_t> position(indices.size());
+    for (size_t j = 0; j < indices.size(); ++j)
+    {
+        cells.emplace_back(std::move(cells_[indices[j]]));
+        position[indices[j]] = j;
+    }
+    cells_.swap(cells);
+
+    // the hashes don't change, only the indices
+    for (auto& slot : slots_)
+        if (slot.index != empty())
+            slot.index = position[slot.index];
+}
+
+template<class C, bool checked_index>
+void
+dionysus::FlatFiltration<C,checked_index>::
+build_index()
+{
+    size_t n = 1;
+    while (n < 2*size()) n *= 2;
+    std::vector<Slot>(n, Slot { 0, empty() }).swap(slots_);
+
+    // drop duplicates (keeping the first occurrence) while indexing
+    size_t j = 0;
+    for (size_t i = 0; i < size(); ++i)
+    {
+        size_t h = hash(cells_[i]);
+        size_t k = probe(cells_[i], h);
+        if (slots_[k].index != empty())
+            continue;
+        if (i != j)
+            cells_[j] = std::move(cells_[i]);
+        slots_[k] = Slot { h, j++ };
+    }
+    cells_.erase(cells_.begin() + j, cells_.end());
+}
+
+template<class C, bool checked_index>
+void
+dionysus::FlatFiltration<C,checked_index>::
+grow(size_t n)
+{
+    size_t sz = slots_.empty() ? 16 : slots_.size();
+    while (sz < n) sz *= 2;
+    if (sz == slots_.size())
+        return;
+
+    std::vector<Slot> slots(sz, Slot { 0, empty() });
+    slots_.swap(slots);
+    for (auto& slot : slots)
+        if (slot.index != empty())
+        {
+            size_t i = slot.hash & mask();
+            while (slots_[i].index != empty())
+                i = (i + 1) & mask();
+            slots_[i] = slot;
+        }
+}
+
+// backward-shift deletion: move up the entries whose probe sequence passes through i
+template<class C, bool checked_index>
+void
+dionysus::FlatFiltration<C,checked_index>::
+erase_slot(size_t i)
+{
+    size_t j = i;
+    while (true)
+    {
+        j = (j + 1) & mask();
+        if (slots_[j].index == empty())
+            break;
+
+        size_t home = slots_[j].hash & mask();
+        // can slots_[j] move into i? only if home is not cyclically in (i, j]
+        if ((j > i && (home <= i || home > j)) || (j < i && (home <= i && home > j)))
+        {
+            slots_[i] = slots_[j];
+            i = j;
+        }
+    }
+    slots_[i].index = empty();
+}
+
+#endif
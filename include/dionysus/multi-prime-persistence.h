@@ -0,0 +1,127 @@
+#ifndef DIONYSUS_MULTI_PRIME_PERSISTENCE_H
+#define DIONYSUS_MULTI_PRIME_PERSISTENCE_H
+
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <algorithm>
+
+#include "reduction.h"      // for unpaired
+#include "fields/multi-zp.h"
+#include "chain.h"
+
+namespace dionysus
+{
+
+// Persistence over K primes at once. Columns are reduced in lockstep over
+// MultiZpField, as long as every prime sees the same pivot, with the same
+// column owning it. Once they diverge, the column splits into K separate Zp
+// columns, each reduced on its own (against both joint and split columns).
+template<unsigned K, typename Index_ = unsigned, class Comparison_ = std::less<Index_>, typename Element_ = short>
+class MultiPrimePersistence
+{
+    public:
+        using   Index       = Index_;
+        using   Comparison  = Comparison_;
+
+        using   Field       = MultiZpField<K, Element_>;
+        using   Prime       = typename Field::BaseElement;
+        using   Primes      = typename Field::Primes;
+        using   Zp          = typename Field::Zp;
+
+        using   Entry       = ChainEntry<Field, Index>;
+        using   Chain       = std::vector<Entry>;
+        using   ZpEntry     = ChainEntry<Zp, Index>;
+        using   ZpChain     = std::vector<ZpEntry>;
+
+        using   Chains      = std::vector<Chain>;
+        using   SplitChains = std::unordered_map<Index, std::array<ZpChain, K>>;
+        using   Pairs       = std::array<std::vector<Index>, K>;
+
+    public:
+                            MultiPrimePersistence(const Primes& primes, const Comparison& cmp = Comparison()):
+                                field_(primes), cmp_(cmp)       {}
+
+        const Field&        field() const                       { return field_; }
+        const Primes&       primes() const                      { return field_.primes(); }
+
+        void                sort(Chain& c)                      { std::sort(c.begin(), c.end(),
+                                                                  [this](const Entry& e1, const Entry& e2)
+                                                                  { return this->cmp_(e1.index(), e2.index()); }); }
+
+        template<class ChainRange>
+        void                add(const ChainRange& chain)        { return add(Chain(std::begin(chain), std::end(chain))); }
+        void                add(Chain&& chain);
+
+        void                reserve(size_t s);
+        size_t              size() const                        { return chains_.size(); }
+
+        // whether column i was split into separate columns for each prime
+        bool                split(Index i) const                { return split_[i]; }
+        size_t              splits() const                      { return split_chains_.size(); }
+
+        const Chain&        chain(Index i) const                { return chains_[i]; }                // empty, if split
+        const ZpChain&      zp_chain(Index i, unsigned k) const { return split_chains_.at(i)[k]; }
+
+        unsigned            lane(Prime p) const                 { return std::find(primes().begin(), primes().end(), p) - primes().begin(); }
+
+        Index               pair(Index i, Prime p) const        { return lane_pair(i, lane(p)); }
+        Index               lane_pair(Index i, unsigned k) const    { return pairs_[k][i]; }
+
+        bool                skip(Index i) const                 { return skip_[i]; }
+        void                add_skip();
+        void                set_skip(Index i, bool flag = true) { skip_[i] = flag; }
+
+        static const Index  unpaired()                          { return Reduction<Index>::unpaired; }
+
+    private:
+        void                set_pair(Index i, Index j, unsigned k)  { pairs_[k][i] = j; pairs_[k][j] = i; }
+
+        void                reduce(ZpChain& c, Index i, unsigned k);
+        ZpChain             lane_chain(const Chain& c, unsigned k) const;
+
+    private:
+        Field               field_;
+        Comparison          cmp_;
+
+        Chains              chains_;
+        SplitChains         split_chains_;
+        std::vector<bool>   split_;
+        std::vector<bool>   skip_;
+        Pairs               pairs_;
+};
+
+// Make MultiPrimePersistence act like a ReducedMatrix over one of its primes (cf. PrimeAdapter)
+template<unsigned K, typename Index_, class Comparison_, typename Element_>
+struct MultiPrimeAdapter
+{
+    using Persistence = MultiPrimePersistence<K, Index_, Comparison_, Element_>;
+    using Prime       = typename Persistence::Prime;
+    using Index       = typename Persistence::Index;
+
+                        MultiPrimeAdapter(const Persistence& persistence, Prime p):
+                            persistence_(persistence), k_(persistence.lane(p))     {}
+
+    bool                skip(Index i) const                     { return persistence_.skip(i); }
+
+    size_t              size() const                            { return persistence_.size(); }
+    Index               pair(Index i) const                     { return persistence_.lane_pair(i, k_); }
+    static const Index  unpaired()                              { return Persistence::unpaired(); }
+
+    const Persistence&  persistence_;
+    unsigned            k_;
+};
+
+template<unsigned K, typename Index, class Comparison, typename Element>
+MultiPrimeAdapter<K, Index, Comparison, Element>
+prime_adapter(const MultiPrimePersistence<K, Index, Comparison, Element>&    persistence,
+              typename MultiPrimeAdapter<K, Index, Comparison, Element>::Prime  p)
+{
+    return MultiPrimeAdapter<K, Index, Comparison, Element>(persistence, p);
+}
+
+} // dionysus
+
+#include "multi-prime-persistence.hpp"
+
+#endif
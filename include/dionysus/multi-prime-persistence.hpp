@@ -0,0 +1,125 @@
+template<unsigned K, typename Index_, class Comparison_, typename Element_>
+void
+dionysus::MultiPrimePersistence<K, Index_, Comparison_, Element_>::
+reserve(size_t s)
+{
+    chains_.reserve(s);
+    split_.reserve(s);
+    skip_.reserve(s);
+    for (auto& pairs : pairs_)
+        pairs.reserve(s);
+}
+
+template<unsigned K, typename Index_, class Comparison_, typename Element_>
+void
+dionysus::MultiPrimePersistence<K, Index_, Comparison_, Element_>::
+add(Chain&& c)
+{
+    sort(c);
+
+    Index i = chains_.size();
+    chains_.emplace_back();
+    split_.push_back(false);
+    skip_.push_back(false);
+    for (auto& pairs : pairs_)
+        pairs.push_back(unpaired());
+
+    auto entry_cmp = [this](const Entry& e1, const Entry& e2) { return this->cmp_(e1.index(), e2.index()); };
+
+    // reduce in lockstep
+    while (!c.empty())
+    {
+        auto& low = c.back();
+        Index l   = low.index();
+        if (!field_.is_unit(low.element()))
+            break;                              // the pivots differ between the primes
+
+        Index o = pairs_[0][l];
+        bool  same = true;
+        for (unsigned k = 1; k < K; ++k)
+            same &= pairs_[k][l] == o;
+        if (!same || (o != unpaired() && split_[o]))
+            break;                              // the pivot is owned by different columns
+
+        if (o == unpaired())
+        {
+            for (unsigned k = 0; k < K; ++k)
+                set_pair(l, i, k);
+            chains_[i] = std::move(c);
+            return;
+        }
+
+        auto& co = chains_[o];
+        auto  m  = field_.neg(field_.div(low.element(), co.back().element()));
+        dionysus::Chain<Chain>::addto(c, m, co, field_, entry_cmp);
+    }
+
+    if (c.empty())
+        return;
+
+    // split
+    split_[i] = true;
+    auto& split = split_chains_[i];
+    for (unsigned k = 0; k < K; ++k)
+    {
+        split[k] = lane_chain(c, k);
+        reduce(split[k], i, k);
+    }
+}
+
+template<unsigned K, typename Index_, class Comparison_, typename Element_>
+void
+dionysus::MultiPrimePersistence<K, Index_, Comparison_, Element_>::
+add_skip()
+{
+    chains_.emplace_back();
+    split_.push_back(false);
+    skip_.push_back(true);
+    for (auto& pairs : pairs_)
+        pairs.push_back(unpaired());
+}
+
+template<unsigned K, typename Index_, class Comparison_, typename Element_>
+void
+dionysus::MultiPrimePersistence<K, Index_, Comparison_, Element_>::
+reduce(ZpChain& c, Index i, unsigned k)
+{
+    auto& field = field_.lane(k);
+    auto  entry_cmp = [this](const ZpEntry& e1, const ZpEntry& e2) { return this->cmp_(e1.index(), e2.index()); };
+
+    ZpChain converted;
+    while (!c.empty())
+    {
+        auto& low = c.back();
+        Index l   = low.index();
+        Index o   = pairs_[k][l];
+        if (o == unpaired())
+        {
+            set_pair(l, i, k);
+            return;
+        }
+
+        // a joint column is converted to lane k for the addition
+        const ZpChain* co = &converted;
+        if (split_[o])
+            co = &split_chains_[o][k];
+        else
+            converted = lane_chain(chains_[o], k);
+
+        auto  m = field.neg(field.div(low.element(), co->back().element()));
+        dionysus::Chain<ZpChain>::addto(c, m, *co, field, entry_cmp);
+    }
+}
+
+template<unsigned K, typename Index_, class Comparison_, typename Element_>
+typename dionysus::MultiPrimePersistence<K, Index_, Comparison_, Element_>::ZpChain
+dionysus::MultiPrimePersistence<K, Index_, Comparison_, Element_>::
+lane_chain(const Chain& c, unsigned k) const
+{
+    ZpChain result;
+    result.reserve(c.size());
+    for (auto& x : c)
+        if (x.element()[k] != 0)
+            result.emplace_back(x.element()[k], x.index());
+    return result;
+}
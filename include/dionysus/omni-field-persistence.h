@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <unordered_map>
+#include <limits>
 
 #include "reduction.h"      // for unpaired
 #include "fields/q.h"
@@ -73,7 +74,14 @@ class OmniFieldPersistence
 
         const Zp&           zp(BaseElement p) const             { auto it = zps_.find(p); if (it != zps_.end()) return it->second; return zps_.emplace(p, Zp(p)).first->second; }
 
-        static Factors      factor(BaseElement x);
+        // Largest prime over which a Zp field is built (its table of inverses has
+        // that many entries); factor() only looks for prime factors up to it.
+        static constexpr BaseElement
+                            max_prime()                         { return std::numeric_limits<BaseElement>::max() < (1 << 20) ?
+                                                                         std::numeric_limits<BaseElement>::max() : (1 << 20); }
+
+        template<class Integer>
+        static Factors      factor(Integer x);
 
         const QChains&      q_chains() const                    { return q_chains_; }
         const ZpChains&     zp_chains() const                   { return zp_chains_; }
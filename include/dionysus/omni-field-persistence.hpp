@@ -38,7 +38,7 @@ add(QChain&& chain)
         assert(!q_.is_zero(e));
         if (e != q_.id())
         {
-            auto factors = factor(q_.numerator(e));
+            auto factors = e.is_big() ? factor(q_.big_numerator(e)) : factor(q_.numerator(e));
             for (auto p : factors)
             {
                 if (!special(i, p))        // there is already a dedicated column over p
@@ -141,13 +141,11 @@ convert(const QChain& c, const Zp& field) const
     auto p = field.prime();
     for (auto& x : c)
     {
-        auto num = q_.numerator(x.element()) % p;
+        auto num = q_.numerator_mod(x.element(), p);
         if (num != 0)
         {
-            while (num < 0) num += p;
-            auto denom = q_.denominator(x.element()) % p;
-            while (denom < 0) denom += p;
-            assert(denom % p != 0);
+            auto denom = q_.denominator_mod(x.element(), p);
+            assert(denom != 0);
             result.emplace_back(field.div(num, denom), x.index());
         }
     }
@@ -156,37 +154,40 @@ convert(const QChain& c, const Zp& field) const
 
 
 template<typename Index_, class Comparison_, class Q_, class Zp_>
+template<class Integer>
 typename dionysus::OmniFieldPersistence<Index_,Comparison_,Q_,Zp_>::Factors
 dionysus::OmniFieldPersistence<Index_, Comparison_,Q_,Zp_>::
-factor(BaseElement x)
+factor(Integer x)
 {
     if (x < 0)
         x = -x;
     Factors result;
 
+    // trial division stops at max_prime(): larger prime factors are never used for a Zp field
+    const BaseElement cap = max_prime();
+
     if (Q::is_prime(x))
     {
-        result.push_back(x);
+        if (x <= cap)
+            result.push_back(static_cast<BaseElement>(x));
         return result;
     }
 
-    BaseElement p { 2 };
-    while (p*p <= x)
+    for (BaseElement p = 2; p <= cap && Integer(p)*p <= x; p += (p == 2 ? 1 : 2))
     {
         if (x % p == 0)
         {
             result.push_back(p);
             do { x /= p; } while (x % p == 0);
             if (Q::is_prime(x))
-            {
-                result.push_back(x);
                 break;
-            }
         }
-        ++p;
     }
-    if (x > 1)
-        result.push_back(x);
+
+    // x is now 1, a prime, or a product of primes above cap; in the last case x > cap,
+    // since a composite x <= cap would have a factor below the last trial divisor
+    if (x > 1 && x <= cap)
+        result.push_back(static_cast<BaseElement>(x));
 
     return result;
 }
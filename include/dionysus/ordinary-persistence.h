@@ -47,7 +47,24 @@ using OrdinaryPersistenceNoNegative = ReducedMatrix<Field, Index, Comparison,
                                                     NoNegative<Field, Index, Comparison>::template Visitor,
                                                     Visitors...>;
 
-// TODO: add clearing optimization (possibly bake it into the code itself)
+// Clearing optimization: a column that's already the pivot of a later column
+// (which happens when columns are reduced out of order, e.g., by decreasing dimension)
+// is positive, so its chain is dropped as soon as it's set; ReducedMatrix::reduce()
+// then skips it.
+template<class Field, typename Index = unsigned, class Comparison = std::less<Index>>
+struct Clearing
+{
+    template<class Self>
+    struct Visitor: public EmptyVisitor<Field, Index, Self>
+    {
+        template<class Chain>
+        void        chain_initialized(Self* matrix, Index i, Chain& c)
+        {
+            if (matrix->positive(i))
+                c.clear();
+        }
+    };
+};
 
 template<class    Field,
          typename Index = unsigned,
@@ -55,7 +72,7 @@ template<class    Field,
          template<class Self> class... Visitors>
 using FastPersistence = ReducedMatrix<Field, Index, Comparison,
                                       NoNegative<Field, Index, Comparison>::template Visitor,
-                                      //Clearing<Field, Index, Comparison>::template Visitor,                    // FIXME
+                                      Clearing<Field, Index, Comparison>::template Visitor,
                                       Visitors...>;
 
 
@@ -1,9 +1,16 @@
 #ifndef DIONYSUS_PAIR_RECORDER_H
 #define DIONYSUS_PAIR_RECORDER_H
 
+#include <vector>
+
+#include "reduction.h"
+
 namespace dionysus
 {
 
+// Records the pairs, and the cells marked skip (by add_skip(), set_skip(), or a
+// kill() that doesn't pair), for persistence types that don't keep them (like
+// CohomologyPersistence); init_diagrams() ignores the skipped cells.
 template<class Persistence_>
 struct PairRecorder: public Persistence_
 {
@@ -18,19 +25,39 @@ struct PairRecorder: public Persistence_
     {
         Index p = Persistence::add(chain);
         pairs_.push_back(p);
+        skip_.push_back(false);
         if (p != unpaired())
             pairs_[p] = pairs_.size() - 1;
 
         return p;
     }
 
+    // the cell only kills; if it doesn't pair, its class is skipped
+    template<class ChainRange>
+    auto                kill(const ChainRange& chain) -> decltype(std::declval<Persistence&>().kill(chain))
+    {
+        Index p = Persistence::kill(chain);
+        pairs_.push_back(p);
+        skip_.push_back(p == unpaired());
+        if (p != unpaired())
+            pairs_[p] = pairs_.size() - 1;
+
+        return p;
+    }
+
+    void                add_skip()                      { Persistence::add_skip(); pairs_.push_back(unpaired()); skip_.push_back(true); }
+
     Index               pair(Index i) const             { return pairs_[i]; }
 
-    void                resize(size_t s)                { Persistence::resize(s); pairs_.resize(s, unpaired()); }
+    bool                skip(Index i) const             { return skip_[i]; }
+    void                set_skip(Index i, bool flag = true) { skip_[i] = flag; }
+
+    void                resize(size_t s)                { Persistence::resize(s); pairs_.resize(s, unpaired()); skip_.resize(s, false); }
     size_t              size() const                    { return pairs_.size(); }
     static const Index  unpaired()                      { return Reduction<Index>::unpaired; }
 
     std::vector<Index>  pairs_;
+    std::vector<char>   skip_;
 };
 
 template<class Persistence_>
@@ -50,6 +77,7 @@ struct PairChainRecorder: public PairRecorder<Persistence_>
         Index p       = std::get<0>(p_chain);
 
         pairs_.push_back(p);
+        skip_.push_back(false);
         chains_.emplace_back();
 
         if (p != unpaired())
@@ -63,12 +91,34 @@ struct PairChainRecorder: public PairRecorder<Persistence_>
 
     using Parent::unpaired;
 
+    template<class ChainRange>
+    auto                kill(const ChainRange& chain) -> decltype(std::declval<Persistence&>().kill(chain))
+    {
+        auto  p_chain = Persistence::add(chain, keep_cocycles, false);
+        Index p       = std::get<0>(p_chain);
+
+        pairs_.push_back(p);
+        skip_.push_back(p == unpaired());
+        chains_.emplace_back();
+
+        if (p != unpaired())
+        {
+            pairs_[p] = pairs_.size() - 1;
+            chains_[p] = std::move(std::get<1>(p_chain));
+        }
+
+        return p;
+    }
+
+    void                add_skip()                      { Parent::add_skip(); chains_.emplace_back(); }
+
     Index               pair(Index i) const             { return pairs_[i]; }
     const Chain&        chain(Index i) const            { return chains_[i]; }      // chain that dies at i
     void                resize(size_t s)                { Parent::resize(s); chains_.resize(s); }
 
     std::vector<Chain>  chains_;
     using Parent::pairs_;
+    using Parent::skip_;
 
     bool                keep_cocycles = true;
 };
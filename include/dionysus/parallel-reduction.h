@@ -0,0 +1,71 @@
+#ifndef DIONYSUS_PARALLEL_REDUCTION_H
+#define DIONYSUS_PARALLEL_REDUCTION_H
+
+#include <vector>
+#include <atomic>
+#include <tuple>
+
+#include "parallel.h"
+
+namespace dionysus
+{
+
+// Mid-level interface, like StandardReduction, but the columns of the
+// ReducedMatrix are reduced by several threads at once, without locks
+// (after Morozov and Nigmetov, "Towards lockfree persistent homology").
+// Every column is published through an atomic pointer, and the ownership of
+// each pivot is claimed with a compare-and-swap; a column that claims a pivot
+// owned by a later column takes it over and sends the later column back for
+// further reduction. Threads take ranges of columns from a shared counter.
+// The resulting pairs are the same as those of StandardReduction.
+// Visitors are not supported: there is no order in which to report the additions.
+template<class Persistence_>
+class ParallelReduction
+{
+    public:
+        typedef         Persistence_                                Persistence;
+        typedef         typename Persistence::Field                 Field;
+        typedef         typename Persistence::Index                 Index;
+        typedef         typename Persistence::Chain                 Chain;
+
+        static_assert(std::tuple_size<typename Persistence::VisitorsTuple>::value == 0, "ParallelReduction doesn't call visitors");
+
+    public:
+                        ParallelReduction(Persistence& persistence, unsigned threads = 0):
+                            persistence_(persistence), threads_(threads)    {}
+
+        template<class Filtration, class Relative, class ReportPair, class Progress>
+        void            operator()(const Filtration& f, const Relative& relative, const ReportPair& report_pair, const Progress& progress);
+
+        template<class Filtration, class ReportPair>
+        void            operator()(const Filtration& f, const ReportPair& report_pair);
+
+        template<class Filtration>
+        void            operator()(const Filtration& f)             { return (*this)(f, &no_report_pair); }
+
+        static void     no_report_pair(int, Index, Index)           {}
+        static void     no_progress()                               {}
+
+        const Persistence&
+                        persistence() const                         { return persistence_; }
+        Persistence&    persistence()                               { return persistence_; }
+
+        // number of columns a thread takes at a time
+        static constexpr size_t     chunk_size = 256;
+
+    private:
+        typedef         std::vector<std::atomic<Chain*>>            Columns;
+        typedef         std::vector<std::atomic<Index>>             Pivots;
+
+        void            reduce(Index j, Chain& c, Columns& columns, Pivots& pivots, std::vector<Index>& queue, std::vector<Chain*>& retired) const;
+
+    private:
+        Persistence&    persistence_;
+        unsigned        threads_;
+};
+
+}
+
+#include "parallel-reduction.hpp"
+
+#endif
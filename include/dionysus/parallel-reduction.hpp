@@ -0,0 +1,170 @@
+#include <boost/range/adaptors.hpp>
+namespace ba = boost::adaptors;
+
+template<class P>
+template<class Filtration, class ReportPair>
+void
+dionysus::ParallelReduction<P>::
+operator()(const Filtration& filtration, const ReportPair& report_pair)
+{
+    (*this)(filtration, NoRelative(), report_pair, no_progress);
+}
+
+template<class P>
+template<class Filtration, class Relative, class ReportPair, class Progress>
+void
+dionysus::ParallelReduction<P>::
+operator()(const Filtration& filtration, const Relative& relative, const ReportPair& report_pair, const Progress& progress)
+{
+    typedef     typename Filtration::Cell                       Cell;
+    typedef     CellBoundaryEntry<Cell, Field>                  CellChainEntry;
+    typedef     ChainEntry<Field, Index>                        ChainEntry;
+
+    Index n = filtration.size();
+    persistence_.resize(n);
+
+    for (Index i = 0; i < n; ++i)
+    {
+        progress();
+        if (relative(filtration[i]))
+            persistence_.set_skip(i);
+    }
+
+    // boundaries
+    parallel_for(n, threads_, [this,&filtration,&relative](size_t b, size_t e)
+    {
+        for (Index i = b; i < e; ++i)
+        {
+            if (persistence_.skip(i))
+                continue;
+
+            auto& c = persistence_.column(i);
+            for (auto&& x : cell_boundary(filtration[i], persistence_.field()) |
+                            ba::filtered([&relative](const CellChainEntry& e) { return !relative(e.index()); }))
+                c.push_back(ChainEntry(x.element(), filtration.index(x.index(), i)));
+            persistence_.sort(c);
+        }
+    });
+
+    // reduction
+    Columns columns(n);
+    Pivots  pivots(n);
+    for (Index i = 0; i < n; ++i)
+    {
+        columns[i].store(&persistence_.column(i), std::memory_order_relaxed);
+        pivots[i].store(persistence_.unpaired(), std::memory_order_relaxed);
+    }
+
+    unsigned threads = default_threads(threads_);
+    std::vector<std::vector<Chain*>> retired(threads);
+    std::atomic<size_t> next(0);
+    parallel_for(threads, threads, [this,n,&next,&columns,&pivots,&retired](size_t t, size_t)
+    {
+        std::vector<Index> queue;
+        Chain              c;
+        while (true)
+        {
+            size_t b = next.fetch_add(chunk_size, std::memory_order_relaxed);
+            if (b >= n)
+                break;
+            size_t e = std::min<size_t>(b + chunk_size, n);
+
+            for (Index j = b; j < e; ++j)
+            {
+                if (persistence_.skip(j))
+                    continue;
+
+                queue.push_back(j);
+                while (!queue.empty())
+                {
+                    Index k = queue.back();
+                    queue.pop_back();
+                    reduce(k, c, columns, pivots, queue, retired[t]);
+                }
+            }
+        }
+    });
+
+    // move the results into the matrix
+    for (Index i = 0; i < n; ++i)
+    {
+        Chain* c = columns[i].load(std::memory_order_relaxed);
+        if (c != &persistence_.column(i))
+        {
+            persistence_.column(i) = std::move(*c);
+            delete c;
+        }
+    }
+    for (auto& r : retired)
+        for (Chain* c : r)
+            delete c;
+
+    for (Index l = 0; l < n; ++l)
+    {
+        Index j = pivots[l].load(std::memory_order_relaxed);
+        if (j != persistence_.unpaired())
+            persistence_.set_pair(l, j);
+    }
+
+    for (Index j = 0; j < n; ++j)
+    {
+        Index pair = persistence_.pair(j);
+        if (!persistence_.skip(j) && pair != persistence_.unpaired() && pair < j)
+            report_pair(filtration[j].dimension(), pair, j);
+    }
+}
+
+template<class P>
+void
+dionysus::ParallelReduction<P>::
+reduce(Index j, Chain& c, Columns& columns, Pivots& pivots, std::vector<Index>& queue, std::vector<Chain*>& retired) const
+{
+    const Field& field     = persistence_.field();
+    auto         entry_cmp = [this](const typename Chain::value_type& e1, const typename Chain::value_type& e2)
+                             { return this->persistence_.cmp()(e1.index(), e2.index()); };
+
+    // c is a working copy: others may be reading the published column
+    const Chain& published = *columns[j].load(std::memory_order_acquire);
+    c.clear();
+    for (auto& x : published)
+        c.emplace_back(x);
+    bool changed = false;
+
+    auto publish = [&]()
+    {
+        Chain* old = columns[j].exchange(new Chain(c), std::memory_order_acq_rel);
+        if (old != &persistence_.column(j))
+            retired.push_back(old);
+        changed = false;
+    };
+
+    while (!c.empty())
+    {
+        Index l = c.back().index();
+        Index o = pivots[l].load(std::memory_order_acquire);
+        if (o != persistence_.unpaired() && o < j)
+        {
+            Chain* co = columns[o].load(std::memory_order_acquire);
+            if (co->empty() || co->back().index() != l)
+                continue;               // o lost the pivot and is being reduced further; look again
+
+            auto m = field.neg(field.div(c.back().element(), co->back().element()));
+            dionysus::Chain<Chain>::addto(c, m, *co, field, entry_cmp);
+            changed = true;
+            continue;
+        }
+
+        // the pivot is free, or owned by a later column: claim it
+        if (changed)
+            publish();
+        if (pivots[l].compare_exchange_strong(o, j, std::memory_order_acq_rel))
+        {
+            if (o != persistence_.unpaired())
+                queue.push_back(o);
+            return;
+        }
+    }
+
+    if (changed)
+        publish();
+}
@@ -0,0 +1,92 @@
+#ifndef DIONYSUS_PARALLEL_H
+#define DIONYSUS_PARALLEL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <iterator>
+#include <algorithm>
+#include <exception>
+
+namespace dionysus
+{
+
+// Number of threads to use, when the caller asks for 0 (meaning "all available")
+inline
+unsigned        default_threads(unsigned threads = 0)
+{
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    return std::max(threads, 1u);
+}
+
+// Split [0, n) into contiguous chunks, one per thread, and call f(begin, end) on each;
+// the calling thread processes the first chunk. The first exception thrown
+// by any of the chunks is rethrown once all of them finish.
+template<class F>
+void            parallel_for(size_t n, unsigned threads, const F& f)
+{
+    threads = std::min<size_t>(default_threads(threads), std::max<size_t>(n, 1));
+
+    size_t chunk = (n + threads - 1) / threads;
+    std::vector<std::exception_ptr> errors(threads);
+    auto run = [&f,&errors,n,chunk](unsigned t)
+    {
+        try
+        {
+            f(std::min(n, t*chunk), std::min(n, (t+1)*chunk));
+        } catch (...)
+        {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t)
+        workers.emplace_back(run, t);
+    run(0);
+
+    for (auto& w : workers)
+        w.join();
+
+    for (auto& e : errors)
+        if (e)
+            std::rethrow_exception(e);
+}
+
+// Multi-producer, multi-consumer queue, for handing items from one thread to
+// another. The consumers don't block: they take whatever has been pushed so far.
+template<class T>
+class ConcurrentQueue
+{
+    public:
+        void            push(T x)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            items_.push_back(std::move(x));
+            size_.store(items_.size(), std::memory_order_release);
+        }
+
+        // append all the items pushed so far to out, in order; returns whether there were any
+        bool            pop_all(std::vector<T>& out)
+        {
+            if (size_.load(std::memory_order_acquire) == 0)
+                return false;
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            out.insert(out.end(), std::make_move_iterator(items_.begin()), std::make_move_iterator(items_.end()));
+            items_.clear();
+            size_.store(0, std::memory_order_relaxed);
+            return true;
+        }
+
+    private:
+        std::mutex              mutex_;
+        std::vector<T>          items_;
+        std::atomic<size_t>     size_ { 0 };
+};
+
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef DIONYSUS_PIPELINE_REDUCTION_H
+#define DIONYSUS_PIPELINE_REDUCTION_H
+
+#include <vector>
+#include <tuple>
+
+#include "reduction.h"
+#include "parallel.h"
+
+namespace dionysus
+{
+
+// Mid-level interface, like ClearingReduction, but the pairs are found by
+// reducing the coboundaries (the anti-transposed boundary matrix, with the
+// columns in reverse filtration order), one dimension per thread, all at once.
+// Clearing goes up in cohomology: the thread of dimension d hands the
+// (d+1)-cells it pairs to the thread of dimension d+1, through a
+// ConcurrentQueue, and that thread skips them, if they arrive before it gets
+// to them. The lower dimensions are cheaper, so their pairs usually do; either
+// way, the pairs are the same as those of ClearingReduction.
+// Each thread builds the coboundaries of its own cells, and looks up only its
+// own pivots, so the threads share nothing but the queues. The matrix records
+// only the pairs (its columns stay empty, and it is marked pairs_only()); they
+// are reported once all the threads finish, from the top dimension down.
+template<class Persistence_>
+class PipelineReduction: public ReductionOptions<typename Persistence_::Index>
+{
+    public:
+        typedef         Persistence_                                Persistence;
+        typedef         typename Persistence::Field                 Field;
+        typedef         typename Persistence::Index                 Index;
+        typedef         typename Persistence::Chain                 Chain;
+
+    public:
+                        PipelineReduction(Persistence& persistence):
+                            persistence_(persistence)               {}
+
+        template<class Filtration, class Relative, class ReportPair, class Progress>
+        void            operator()(const Filtration& f, const Relative& relative, const ReportPair& report_pair, const Progress& progress);
+
+        template<class Filtration, class ReportPair>
+        void            operator()(const Filtration& f, const ReportPair& report_pair);
+
+        template<class Filtration>
+        void            operator()(const Filtration& f)             { return (*this)(f, &no_report_pair); }
+
+        static void     no_report_pair(int, Index, Index)           {}
+        static void     no_progress()                               {}
+
+        const Persistence&
+                        persistence() const                         { return persistence_; }
+        Persistence&    persistence()                               { return persistence_; }
+
+    private:
+        typedef         std::vector<Index>                          Indices;
+        typedef         std::tuple<Index, Index>                    Pair;       // (birth, death)
+
+        // reduce the coboundaries of the cells of dimension d, skipping the ones that
+        // come through cleared, and pass the deaths on to upper
+        template<class Filtration, class Relative>
+        void            reduce(const Filtration& f, const Relative& relative, const std::vector<Indices>& cells, const Indices& ranks,
+                               size_t d, ConcurrentQueue<Index>& cleared, ConcurrentQueue<Index>* upper,
+                               std::vector<Pair>& pairs, ReductionStatistics& statistics) const;
+
+    private:
+        Persistence&    persistence_;
+};
+
+}
+
+#include "pipeline-reduction.hpp"
+
+#endif
@@ -0,0 +1,158 @@
+#include <algorithm>
+
+#include <boost/range/adaptors.hpp>
+namespace ba = boost::adaptors;
+
+template<class P>
+template<class Filtration, class ReportPair>
+void
+dionysus::PipelineReduction<P>::
+operator()(const Filtration& filtration, const ReportPair& report_pair)
+{
+    (*this)(filtration, NoRelative(), report_pair, &no_progress);
+}
+
+template<class P>
+template<class Filtration, class Relative, class ReportPair, class Progress>
+void
+dionysus::PipelineReduction<P>::
+operator()(const Filtration& filtration, const Relative& relative, const ReportPair& report_pair, const Progress& progress)
+{
+    Index n = filtration.size();
+    persistence_.resize(n);
+    persistence_.set_pairs_only();
+    this->statistics_ = ReductionStatistics();
+
+    // the cells of every dimension, in order, and the rank of every cell among them
+    std::vector<Indices>    cells;
+    Indices                 ranks(n);
+    for (Index i = 0; i < n; ++i)
+    {
+        progress();
+        const auto& c = filtration[i];
+        if (relative(c))
+        {
+            persistence_.set_skip(i);
+            continue;
+        }
+
+        if (this->above(c.dimension()))
+        {
+            persistence_.set_skip(i);
+            ++this->statistics_.skipped;
+            continue;
+        }
+
+        if (cells.size() <= c.dimension())
+            cells.resize(c.dimension() + 1);
+        ranks[i] = cells[c.dimension()].size();
+        cells[c.dimension()].push_back(i);
+    }
+
+    // the cells of the top dimension have no coboundaries to reduce
+    size_t                              dims = cells.size() > 0 ? cells.size() - 1 : 0;
+    std::vector<ConcurrentQueue<Index>> cleared(dims);
+    std::vector<std::vector<Pair>>      pairs(dims);
+    std::vector<ReductionStatistics>    statistics(dims);
+    parallel_for(dims, dims, [&](size_t b, size_t e)
+    {
+        for (size_t d = b; d < e; ++d)
+            reduce(filtration, relative, cells, ranks, d, cleared[d], d + 1 < dims ? &cleared[d+1] : nullptr, pairs[d], statistics[d]);
+    });
+
+    for (auto& s : statistics)
+    {
+        this->statistics_.reduced += s.reduced;
+        this->statistics_.cleared += s.cleared;
+    }
+
+    for (size_t d = dims; d-- > 0;)
+    {
+        auto& dpairs = pairs[d];
+        std::sort(dpairs.begin(), dpairs.end(), [](const Pair& x, const Pair& y) { return std::get<1>(x) < std::get<1>(y); });
+        for (auto& p : dpairs)
+        {
+            Index i = std::get<0>(p),
+                  j = std::get<1>(p);
+            persistence_.set_pair(i, j);
+            if (this->filtered(i, j))
+            {
+                persistence_.set_skip(i);
+                persistence_.set_skip(j);
+            } else
+                report_pair(d + 1, i, j);
+        }
+    }
+
+    // the classes of the top dimension are above the maximum
+    if (this->max_dimension() >= 0 && cells.size() > size_t(this->max_dimension() + 1))
+        for (Index i : cells[this->max_dimension() + 1])
+            if (persistence_.pair(i) == persistence_.unpaired())
+                persistence_.set_skip(i);
+}
+
+template<class P>
+template<class Filtration, class Relative>
+void
+dionysus::PipelineReduction<P>::
+reduce(const Filtration& filtration, const Relative& relative, const std::vector<Indices>& cells, const Indices& ranks,
+       size_t d, ConcurrentQueue<Index>& cleared, ConcurrentQueue<Index>* upper,
+       std::vector<Pair>& pairs, ReductionStatistics& statistics) const
+{
+    typedef     typename Filtration::Cell                       Cell;
+    typedef     CellBoundaryEntry<Cell, Field>                  CellChainEntry;
+    typedef     typename Chain::value_type                      Entry;
+    typedef     typename Field::Element                         FieldElement;
+
+    const Field&    field   = persistence_.field();
+    const Indices&  columns = cells[d];
+    Index           n       = filtration.size();
+
+    // coboundaries, by rank; the entries are the reversed indices, n-1-j, of the cofacets j,
+    // so that, as in the boundary matrix, the pivot is the largest (the oldest cofacet)
+    std::vector<Chain> coboundaries(columns.size());
+    for (Index j : cells[d+1])
+        for (auto&& x : cell_boundary(filtration[j], field) |
+                        ba::filtered([&relative](const CellChainEntry& e) { return !relative(e.index()); }))
+            coboundaries[ranks[filtration.index(x.index(), j)]].emplace_back(x.element(), n - 1 - j);
+    for (auto& c : coboundaries)
+        std::reverse(c.begin(), c.end());
+
+    // the pivots, by the rank of the (d+1)-cell, point to the ranks of their columns
+    Indices             pivots(cells[d+1].size(), persistence_.unpaired());
+    std::vector<char>   negative(columns.size(), false);
+    Indices             deaths;
+    auto                chains  = [&coboundaries](Index o) -> const Chain&  { return coboundaries[o]; };
+    auto                pair    = [&pivots,&ranks,n](Index l)              { return pivots[ranks[n - 1 - l]]; };
+    auto                cmp     = [](const Entry& e1, const Entry& e2)     { return e1.index() < e2.index(); };
+
+    for (Index k = columns.size(); k-- > 0;)
+    {
+        if (cleared.pop_all(deaths))
+        {
+            for (Index j : deaths)
+            {
+                negative[ranks[j]] = true;
+                Chain().swap(coboundaries[ranks[j]]);
+            }
+            deaths.clear();
+        }
+
+        if (negative[k])
+        {
+            ++statistics.cleared;
+            continue;
+        }
+
+        Index l = Reduction<Index>::reduce(coboundaries[k], chains, pair, field, [](FieldElement, Index) {}, cmp);
+        ++statistics.reduced;
+        if (l == persistence_.unpaired())
+            continue;
+
+        Index j = n - 1 - l;
+        pivots[ranks[j]] = k;
+        pairs.emplace_back(columns[k], j);
+        if (upper)
+            upper->push(j);
+    }
+}
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <tuple>
+#include <type_traits>
 
 #include "chain.h"
 #include "reduction.h"
@@ -59,7 +60,10 @@ class ReducedMatrix
                                     cmp_(other.cmp_),
                                     reduced_(std::move(other.reduced_)),
                                     pairs_(std::move(other.pairs_)),
-                                    skip_(std::move(other.skip_))               {}
+                                    skip_(std::move(other.skip_)),
+                                    reduced_upto_(other.reduced_upto_),
+                                    heap_column_(other.heap_column_),
+                                    pairs_only_(other.pairs_only_)              {}
 
                                     // FIXME
                                     //visitors_(std::move(other.visitors_))       {}
@@ -73,19 +77,32 @@ class ReducedMatrix
         void                    set(Index i, Chain&& chain);
 
         Index                   reduce(Index i);
+        // zero the column of a positive cell without reducing it (clearing);
+        // visitors see column_cleared(i, pair(i))
+        void                    clear_positive(Index i);
         Index                   reduce(Index i, Chain& c)       { return reduce(i, c, reduced_, pairs_); }
         template<class ChainsLookup, class PairLookup>
         Index                   reduce(Index i, Chain& c, const ChainsLookup& chains, const PairLookup& pair);
 
-        Index                   reduce_upto(Index i);           // TODO
+        // Progressive reduction: reduce the (already set) columns from reduced() up to,
+        // but not including, i, in order; the next call resumes where this one stopped.
+        // The pairs of the prefix are final (see init_diagrams() for its diagrams).
+        Index                   reduce_upto(Index i)            { return reduce_upto(i, [](){ return false; }); }
+        // same, but stops (before a column) as soon as stop() returns true, e.g., past a time budget
+        template<class Stop>
+        Index                   reduce_upto(Index i, const Stop& stop);
+        // number of columns reduced in order (by reduce_upto() or add())
+        Index                   reduced() const                 { return reduced_upto_; }
 
         size_t                  size() const                    { return pairs_.size(); }
-        void                    clear()                         { Chains().swap(reduced_); Indices().swap(pairs_); }
+        void                    clear()                         { Chains().swap(reduced_); Indices().swap(pairs_); reduced_upto_ = 0; }
 
         void                    sort(Chain& c)                  { std::sort(c.begin(), c.end(), [this](const Entry& e1, const Entry& e2) { return this->cmp_(e1.index(), e2.index()); }); }
 
         const Chain&            operator[](Index i) const       { return reduced_[i]; }
         Index                   pair(Index i) const             { return pairs_[i]; }
+        // i is paired with a later column (and so is known to reduce to zero)
+        bool                    positive(Index i) const         { return pairs_[i] != unpaired() && i < pairs_[i]; }
         void                    set_pair(Index i, Index j)      { pairs_[i] = j; pairs_[j] = i; }
 
         Chain&                  column(Index i)                 { return reduced_[i]; }
@@ -94,6 +111,16 @@ class ReducedMatrix
         void                    add_skip();
         void                    set_skip(Index i, bool flag = true) { skip_[i] = flag; }
 
+        // reduce the working column as a HeapColumn (see Reduction::reduce_heap()); over
+        // fields with lazy arithmetic (ZpField), as a LazyHeapColumn (see Reduction::reduce_lazy())
+        void                    set_heap_column(bool flag = true)   { heap_column_ = flag; }
+        bool                    heap_column() const             { return heap_column_; }
+
+        // the matrix records only the pairs (and skips), e.g., after PipelineReduction;
+        // its columns are empty, so they say nothing about the reduced cycles
+        void                    set_pairs_only(bool flag = true)    { pairs_only_ = flag; }
+        bool                    pairs_only() const              { return pairs_only_; }
+
         const Field&            field() const                   { return field_; }
         const Comparison&       cmp() const                     { return cmp_; }
         void                    reserve(size_t s)               { reduced_.reserve(s); pairs_.reserve(s); }
@@ -110,6 +137,21 @@ class ReducedMatrix
         template<class F, class I, class C, template<class S> class... Vs>
         friend class ReducedMatrix;     // let's all be friends
 
+        // over Z2, with the natural order of indices, the working column is a BitTree
+        typedef                 std::integral_constant<bool, std::is_same<Field, Z2Field>::value &&
+                                                             std::is_same<Comparison, std::less<Index>>::value>
+                                                                BitTreeApplies;
+
+        template<class ChainsLookup, class PairLookup, class Visitor_>
+        Index                   reduce_bit_tree(Chain& c, const ChainsLookup& chains, const PairLookup& pairs, const Visitor_& visitor, std::true_type);
+        template<class ChainsLookup, class PairLookup, class Visitor_>
+        Index                   reduce_bit_tree(Chain&, const ChainsLookup&, const PairLookup&, const Visitor_&, std::false_type)     { return unpaired(); }
+
+        template<class ChainsLookup, class PairLookup, class Visitor_, class EntryComparison>
+        Index                   reduce_heap(Chain& c, const ChainsLookup& chains, const PairLookup& pairs, const Visitor_& visitor, const EntryComparison&, std::true_type);
+        template<class ChainsLookup, class PairLookup, class Visitor_, class EntryComparison>
+        Index                   reduce_heap(Chain& c, const ChainsLookup& chains, const PairLookup& pairs, const Visitor_& visitor, const EntryComparison& entry_cmp, std::false_type);
+
     public:
         // Visitors::resized(sz)
         template<std::size_t I = 0>
@@ -138,6 +180,15 @@ class ReducedMatrix
         typename std::enable_if<I < sizeof...(Visitors), void>::type
                                 visitors_addto(Index i, FieldElement m, Index cl)    { std::get<I>(visitors_).addto(this, i, m, cl); visitors_addto<I+1>(i, m, cl); }
 
+        // Visitors::column_cleared(i, j)
+        template<std::size_t I = 0>
+        typename std::enable_if<I == sizeof...(Visitors), void>::type
+                                visitors_column_cleared(Index i, Index j)            {}
+
+        template<std::size_t I = 0>
+        typename std::enable_if<I < sizeof...(Visitors), void>::type
+                                visitors_column_cleared(Index i, Index j)            { std::get<I>(visitors_).column_cleared(this, i, j); visitors_column_cleared<I+1>(i, j); }
+
         // Visitors::reduction_finished(m, cl)
         template<std::size_t I = 0>
         typename std::enable_if<I == sizeof...(Visitors), void>::type
@@ -153,9 +204,40 @@ class ReducedMatrix
         Chains                  reduced_;       // matrix R
         Indices                 pairs_;
         SkipFlags               skip_;          // indicates whether the column should be skipped (e.g., for relative homology)
+        Index                   reduced_upto_ = 0;
+        bool                    heap_column_ = false;
+        bool                    pairs_only_ = false;
         VisitorsTuple           visitors_;
 };
 
+// Progressive reduction by value: reduce the columns of the cells of f, sorted by
+// get_value(cell, index) (as in init_diagrams()), with values up to and including x;
+// the prefix ends at the first value above x, found by binary search. Returns m.reduced().
+template<class ReducedMatrix, class Filtration, class Value, class GetValue, class Stop>
+typename ReducedMatrix::Index
+reduce_upto(ReducedMatrix& m, const Filtration& f, const Value& x, const GetValue& get_value, const Stop& stop)
+{
+    using Index = typename ReducedMatrix::Index;
+
+    Index lo = 0, hi = f.size();
+    while (lo < hi)
+    {
+        Index mid = lo + (hi - lo) / 2;
+        if (x < get_value(f[mid], mid))
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return m.reduce_upto(lo, stop);
+}
+
+template<class ReducedMatrix, class Filtration, class Value, class GetValue>
+typename ReducedMatrix::Index
+reduce_upto(ReducedMatrix& m, const Filtration& f, const Value& x, const GetValue& get_value)
+{
+    return reduce_upto(m, f, x, get_value, [](){ return false; });
+}
+
 /*  Visitors */
 
 // The prototypical visitor. Others may (and probably should) inherit from it.
@@ -174,6 +256,8 @@ struct EmptyVisitor
     void        chain_initialized(Self*, Index i, Chain& c)                 {}
 
     void        addto(Self*, Index i, typename Field::Element m, Index o)   {}
+    // column i is positive, paired with j, and was zeroed without a reduction
+    void        column_cleared(Self*, Index i, Index j)                     {}
     void        reduction_finished(Self*)                                   {}
 };
 
@@ -6,6 +6,7 @@ resize(size_t s)
     reduced_.resize(s);
     pairs_.resize(s, unpaired());
     skip_.resize(s, false);
+    reduced_upto_ = std::min<Index>(reduced_upto_, s);
 
     visitors_resized(size());
 }
@@ -15,7 +16,6 @@ typename dionysus::ReducedMatrix<F,I,C,V...>::Index
 dionysus::ReducedMatrix<F,I,C,V...>::
 add(Chain&& chain)
 {
-    // TODO: skip the computation entirely if we already know this is positive (in case of the clearing optimization)
     Index i = pairs_.size();
     pairs_.emplace_back(unpaired());
     reduced_.emplace_back();
@@ -25,7 +25,10 @@ add(Chain&& chain)
 
     set(i, std::move(chain));
 
-    return reduce(i);
+    Index pair = reduce(i);
+    if (reduced_upto_ == i)
+        ++reduced_upto_;
+    return pair;
 }
 
 template<class F, typename I, class C, template<class Self> class... V>
@@ -36,6 +39,8 @@ add_skip()
     pairs_.emplace_back(unpaired());
     reduced_.emplace_back();
     skip_.push_back(true);
+    if (reduced_upto_ == size() - 1)
+        ++reduced_upto_;
 
     visitors_resized(size());
 }
@@ -56,6 +61,15 @@ dionysus::ReducedMatrix<F,I,C,V...>::
 reduce(Index i)
 {
     Chain& c    = column(i);
+
+    // clearing: a later column already has i as its pivot, so i is positive
+    if (positive(i))
+    {
+        clear_positive(i);
+        visitors_reduction_finished<>();
+        return unpaired();
+    }
+
     Index  pair = reduce(i, c);
 
     if (pair != unpaired())
@@ -67,6 +81,32 @@ reduce(Index i)
     return pair;
 }
 
+template<class F, typename I, class C, template<class Self> class... V>
+void
+dionysus::ReducedMatrix<F,I,C,V...>::
+clear_positive(Index i)
+{
+    column(i).clear();
+    visitors_column_cleared<>(i, pairs_[i]);
+}
+
+template<class F, typename I, class C, template<class Self> class... V>
+template<class Stop>
+typename dionysus::ReducedMatrix<F,I,C,V...>::Index
+dionysus::ReducedMatrix<F,I,C,V...>::
+reduce_upto(Index i, const Stop& stop)
+{
+    i = std::min<Index>(i, size());
+    for (; reduced_upto_ < i; ++reduced_upto_)
+    {
+        if (stop())
+            break;
+        if (!skip(reduced_upto_))
+            reduce(reduced_upto_);
+    }
+    return reduced_upto_;
+}
+
 template<class F, typename I, class C, template<class Self> class... V>
 template<class ChainsLookup,
          class PairLookup>
@@ -78,8 +118,45 @@ reduce(      Index                 i,
        const PairLookup&           pairs)
 {
     auto entry_cmp = [this](const Entry& e1, const Entry& e2) { return this->cmp_(e1.index(), e2.index()); };
-    return Reduction<Index>::reduce(c, chains, pairs, field_,
-                                    [this,i](FieldElement m, Index o)
-                                    { this->visitors_addto<>(i, m, o); },
-                                    entry_cmp);
+    auto visitor   = [this,i](FieldElement m, Index o) { this->visitors_addto<>(i, m, o); };
+    if (BitTreeApplies::value)
+        return reduce_bit_tree(c, chains, pairs, visitor, BitTreeApplies());
+    if (heap_column_)
+        return reduce_heap(c, chains, pairs, visitor, entry_cmp, detail::LazyField<Field>());
+    return Reduction<Index>::reduce(c, chains, pairs, field_, visitor, entry_cmp);
+}
+
+template<class F, typename I, class C, template<class Self> class... V>
+template<class ChainsLookup,
+         class PairLookup,
+         class Visitor_>
+typename dionysus::ReducedMatrix<F,I,C,V...>::Index
+dionysus::ReducedMatrix<F,I,C,V...>::
+reduce_bit_tree(Chain& c, const ChainsLookup& chains, const PairLookup& pairs, const Visitor_& visitor, std::true_type)
+{
+    return Reduction<Index>::reduce_bit_tree(c, chains, pairs, field_, visitor);
+}
+
+template<class F, typename I, class C, template<class Self> class... V>
+template<class ChainsLookup,
+         class PairLookup,
+         class Visitor_,
+         class EntryComparison>
+typename dionysus::ReducedMatrix<F,I,C,V...>::Index
+dionysus::ReducedMatrix<F,I,C,V...>::
+reduce_heap(Chain& c, const ChainsLookup& chains, const PairLookup& pairs, const Visitor_& visitor, const EntryComparison&, std::true_type)
+{
+    return Reduction<Index>::reduce_lazy(c, chains, pairs, field_, visitor, cmp_);
+}
+
+template<class F, typename I, class C, template<class Self> class... V>
+template<class ChainsLookup,
+         class PairLookup,
+         class Visitor_,
+         class EntryComparison>
+typename dionysus::ReducedMatrix<F,I,C,V...>::Index
+dionysus::ReducedMatrix<F,I,C,V...>::
+reduce_heap(Chain& c, const ChainsLookup& chains, const PairLookup& pairs, const Visitor_& visitor, const EntryComparison& entry_cmp, std::false_type)
+{
+    return Reduction<Index>::reduce_heap(c, chains, pairs, field_, visitor, entry_cmp);
 }
@@ -5,7 +5,10 @@
 #include <tuple>
 #include <functional>
 #include <limits>
+#include <algorithm>
+#include <type_traits>
 #include "chain.h"
+#include "bit-tree-column.h"
 
 namespace dionysus
 {
@@ -17,8 +20,120 @@ template<class Index>
 struct Unpaired
 { static constexpr Index value()          { return std::numeric_limits<Index>::max(); } };
 
+inline
+BitTree&    scratch_bit_tree()              { static thread_local BitTree tree; return tree; }
+
+}
+
+// Working column kept as a max-heap of entries (with respect to cmp). Additions
+// only push entries; entries with equal indices are combined (and cancelled)
+// lazily, when they reach the top, so only the pivot is ever kept exact.
+template<class Chain_, class Field_, class Comparison_>
+class HeapColumn
+{
+    public:
+        typedef     Chain_                                  Chain;
+        typedef     Field_                                  Field;
+        typedef     Comparison_                             Comparison;
+        typedef     typename Chain::value_type              Entry;
+        typedef     typename Field::Element                 FieldElement;
+
+    public:
+                    HeapColumn(Chain& heap, const Field& field, const Comparison& cmp):
+                        heap_(heap), field_(field), cmp_(cmp)       {}
+
+        // take over the (sorted) chain c
+        void        assign(Chain& c)                        { heap_.swap(c); c.clear(); std::make_heap(heap_.begin(), heap_.end(), cmp_); }
+
+        // combine the entries at the top; returns false if the column is zero
+        bool        pivot();
+        const Entry&    top() const                         { return heap_.front(); }
+        void        pop()                                   { std::pop_heap(heap_.begin(), heap_.end(), cmp_); heap_.pop_back(); }
+
+        // column += a*chain, skipping the last (lowest) entry of chain
+        template<class Chain2>
+        void        add_all_but_low(FieldElement a, const Chain2& chain);
+
+        // store the column, sorted, in c, and empty the heap
+        void        finalize(Chain& c);
+
+    private:
+        Chain&              heap_;
+        const Field&        field_;
+        const Comparison&   cmp_;
+};
+
+namespace detail
+{
+    // whether Field provides lazy arithmetic (like ZpField)
+    template<class Field, class = void>
+    struct LazyField: std::false_type {};
+
+    template<class Field>
+    struct LazyField<Field, decltype(std::declval<const Field&>().lazy_bound(), void())>: std::true_type {};
 }
 
+// Working column like HeapColumn, over a field with lazy arithmetic (ZpField): the
+// entries hold unreduced products a*y (lazy_mul()), and the entries with equal indices
+// are summed as they are. The sum is reduced only when it reaches the top and has to be
+// checked for zero (and, to avoid overflow, every lazy_bound() terms), so additions
+// don't reduce at all.
+template<class Field_, class Index_, class Comparison_>
+class LazyHeapColumn
+{
+    public:
+        typedef     Field_                                  Field;
+        typedef     Index_                                  Index;
+        typedef     Comparison_                             Comparison;     // on indices
+        typedef     typename Field::Element                 FieldElement;
+        typedef     typename Field::Accumulator             Accumulator;
+
+        struct      Entry
+        {
+            Accumulator     value;
+            Index           i;
+        };
+        typedef     std::vector<Entry>                      Entries;
+
+    public:
+                    LazyHeapColumn(Entries& heap, const Field& field, const Comparison& cmp):
+                        heap_(heap), field_(field), cmp_(cmp),
+                        bound_(field.lazy_bound())                  { heap_.clear(); }
+
+        // take over the entries of c, and empty c
+        template<class Chain>
+        void        assign(Chain& c);
+
+        // combine and reduce the entries at the top; returns false if the column is zero
+        bool        pivot();
+        Index       index() const                           { return heap_.front().i; }
+        // the (reduced) element at the top, after pivot()
+        FieldElement    element() const                     { return FieldElement(heap_.front().value); }
+        void        pop()                                   { std::pop_heap(heap_.begin(), heap_.end(), order()); heap_.pop_back(); }
+
+        // column += a*chain, skipping the last (lowest) entry of chain
+        template<class Chain2>
+        void        add_all_but_low(FieldElement a, const Chain2& chain);
+
+        // store the column, sorted and reduced, in c, and empty the heap
+        template<class Chain>
+        void        finalize(Chain& c);
+
+    private:
+        struct      Order
+        {
+            bool                operator()(const Entry& x, const Entry& y) const    { return cmp(x.i, y.i); }
+            const Comparison&   cmp;
+        };
+        Order       order() const                           { return Order { cmp_ }; }
+
+    private:
+        Entries&            heap_;
+        const Field&        field_;
+        const Comparison&   cmp_;
+        Accumulator         bound_;
+};
+
 template<class Index_>
 struct Reduction
 {
@@ -44,6 +159,26 @@ struct Reduction
                  const Field&                field,
                  const AddtoVisitor<Field>&  visitor = [](typename Field::Element, Index) {},
                  const Comparison&           cmp     = Comparison())
+    {
+        return reduce(c, detail::scratch_chain<Chain1>(), chains, pairs, field, visitor, cmp);
+    }
+
+    // Reduce c until its pivot is new, merging every addition through scratch
+    // (see Chain<C1>::addto()): c and scratch trade storage, so once they have
+    // grown, the loop doesn't allocate.
+    template<class Chain1,
+             class ChainsLookup,
+             class PairLookup,
+             class Field,
+             class Comparison = std::less<Index>>
+    static
+    Index reduce(Chain1&                     c,
+                 Chain1&                     scratch,
+                 const ChainsLookup&         chains,
+                 const PairLookup&           pairs,
+                 const Field&                field,
+                 const AddtoVisitor<Field>&  visitor = [](typename Field::Element, Index) {},
+                 const Comparison&           cmp     = Comparison())
     {
         typedef     typename Field::Element         FieldElement;
 
@@ -62,13 +197,146 @@ struct Reduction
                 auto&           co_low = co.back();
                 FieldElement    m      = field.neg(field.div(low.element(), co_low.element()));
                 // c += m*co
-                Chain<Chain1>::addto(c, m, co, field, cmp);
+                Chain<Chain1>::addto(c, m, co, field, cmp, scratch);
                 visitor(m, o);
             }
         }
         return unpaired;
     }
 
+    // Same as reduce(), but c is reduced as a HeapColumn: every step pushes the
+    // entries of the pivot's column, instead of merging it into c, and the full
+    // sort happens once, at the end. Better for long columns that receive many
+    // additions. Chain1 must be a random-access container (e.g., std::vector).
+    template<class Chain1,
+             class ChainsLookup,
+             class PairLookup,
+             class Field,
+             class Comparison = std::less<Index>>
+    static
+    Index reduce_heap(Chain1&                     c,
+                      const ChainsLookup&         chains,
+                      const PairLookup&           pairs,
+                      const Field&                field,
+                      const AddtoVisitor<Field>&  visitor = [](typename Field::Element, Index) {},
+                      const Comparison&           cmp     = Comparison())
+    {
+        typedef     typename Field::Element         FieldElement;
+
+        HeapColumn<Chain1, Field, Comparison> heap(detail::scratch_chain<Chain1>(), field, cmp);
+        heap.assign(c);
+
+        while (heap.pivot())
+        {
+            auto&  low = heap.top();
+            Index  l   = low.index();
+            Index  o   = pairs(l);
+            if (o == unpaired)
+            {
+                heap.finalize(c);
+                return l;
+            }
+
+            // Reduce further
+            auto&           co     = chains(o);
+            auto&           co_low = co.back();
+            FieldElement    m      = field.neg(field.div(low.element(), co_low.element()));
+            // c += m*co; the lows cancel
+            heap.pop();
+            heap.add_all_but_low(m, co);
+            visitor(m, o);
+        }
+        return unpaired;
+    }
+
+    // Same as reduce_heap(), but over a field with lazy arithmetic (see LazyHeapColumn):
+    // the additions push unreduced products, and only the pivots are reduced. Unlike
+    // the other reductions, cmp compares indices, not entries.
+    template<class Chain1,
+             class ChainsLookup,
+             class PairLookup,
+             class Field,
+             class Comparison = std::less<Index>>
+    static
+    Index reduce_lazy(Chain1&                     c,
+                      const ChainsLookup&         chains,
+                      const PairLookup&           pairs,
+                      const Field&                field,
+                      const AddtoVisitor<Field>&  visitor = [](typename Field::Element, Index) {},
+                      const Comparison&           cmp     = Comparison())
+    {
+        typedef     typename Field::Element                     FieldElement;
+        typedef     LazyHeapColumn<Field, Index, Comparison>    Column;
+
+        Column heap(detail::scratch_chain<typename Column::Entries>(), field, cmp);
+        heap.assign(c);
+
+        while (heap.pivot())
+        {
+            Index  l   = heap.index();
+            Index  o   = pairs(l);
+            if (o == unpaired)
+            {
+                heap.finalize(c);
+                return l;
+            }
+
+            // Reduce further
+            auto&           co     = chains(o);
+            auto&           co_low = co.back();
+            FieldElement    m      = field.neg(field.div(heap.element(), co_low.element()));
+            // c += m*co; the lows cancel
+            heap.pop();
+            heap.add_all_but_low(m, co);
+            visitor(m, o);
+        }
+        return unpaired;
+    }
+
+    // Z2 only, with indices ordered by std::less: the working column is a BitTree,
+    // so adding a column toggles its indices and the pivot is the largest set bit.
+    template<class Chain1,
+             class ChainsLookup,
+             class PairLookup,
+             class Field>
+    static
+    Index reduce_bit_tree(Chain1&                     c,
+                          const ChainsLookup&         chains,
+                          const PairLookup&           pairs,
+                          const Field&                field,
+                          const AddtoVisitor<Field>&  visitor = [](typename Field::Element, Index) {})
+    {
+        if (c.empty())
+            return unpaired;
+
+        BitTree& tree = detail::scratch_bit_tree();
+        tree.reserve(static_cast<size_t>(c.back().index()) + 1);
+        for (auto& e : c)
+            tree.toggle(e.index());
+
+        while (!tree.empty())
+        {
+            Index  l   = tree.max();
+            Index  o   = pairs(l);
+            if (o == unpaired)
+            {
+                c.clear();
+                while (!tree.empty())
+                    c.emplace_back(field.id(), static_cast<Index>(tree.pop_max()));
+                std::reverse(c.begin(), c.end());
+                return l;
+            }
+
+            // c += co; the lows cancel
+            auto& co = chains(o);
+            for (auto& e : co)
+                tree.toggle(e.index());
+            visitor(field.id(), o);
+        }
+        c.clear();
+        return unpaired;
+    }
+
     template<class Chain1,
              class Chain2,
              class Field,
@@ -87,6 +355,58 @@ struct Reduction
                       field, visitor, cmp);
     }
 
+    template<class Chain1,
+             class Chain2,
+             class Field,
+             class Comparison = std::less<Index>>
+    static
+    Index reduce_heap(Chain1&                     c,
+                      const std::vector<Chain2>&  chains,
+                      const std::vector<Index>&   lows,
+                      const Field&                field,
+                      const AddtoVisitor<Field>&  visitor = [](typename Field::Element, Index) {},
+                      const Comparison&           cmp     = Comparison())
+    {
+        return reduce_heap(c,
+                           CallToSub<Chain2>(chains),
+                           CallToSub<Index>(lows),
+                           field, visitor, cmp);
+    }
+
+    template<class Chain1,
+             class Chain2,
+             class Field,
+             class Comparison = std::less<Index>>
+    static
+    Index reduce_lazy(Chain1&                     c,
+                      const std::vector<Chain2>&  chains,
+                      const std::vector<Index>&   lows,
+                      const Field&                field,
+                      const AddtoVisitor<Field>&  visitor = [](typename Field::Element, Index) {},
+                      const Comparison&           cmp     = Comparison())
+    {
+        return reduce_lazy(c,
+                           CallToSub<Chain2>(chains),
+                           CallToSub<Index>(lows),
+                           field, visitor, cmp);
+    }
+
+    template<class Chain1,
+             class Chain2,
+             class Field>
+    static
+    Index reduce_bit_tree(Chain1&                     c,
+                          const std::vector<Chain2>&  chains,
+                          const std::vector<Index>&   lows,
+                          const Field&                field,
+                          const AddtoVisitor<Field>&  visitor = [](typename Field::Element, Index) {})
+    {
+        return reduce_bit_tree(c,
+                               CallToSub<Chain2>(chains),
+                               CallToSub<Index>(lows),
+                               field, visitor);
+    }
+
     // This is a work-around a bug in GCC (should really be a lambda function)
     template<class Item>
     struct CallToSub
@@ -103,6 +423,193 @@ template<class Index>
 const Index
 Reduction<Index>::unpaired = detail::Unpaired<Index>::value();
 
+
+// What a reduction did, given its options (ReductionOptions)
+struct ReductionStatistics
+{
+    size_t      reduced  = 0;       // columns reduced
+    size_t      skipped  = 0;       // cells above the maximum dimension, never reduced
+    size_t      cleared  = 0;       // columns zeroed by clearing, without reduction
+    size_t      filtered = 0;       // pairs below the report threshold, reduced but not reported
+};
+
+// Options shared by the reductions (StandardReduction, ClearingReduction, PipelineReduction)
+template<class Index_>
+class ReductionOptions
+{
+    public:
+        typedef         Index_                                      Index;
+        typedef         std::function<double(Index)>                Value;
+
+    public:
+        // Compute homology only up to dimension d: the cells of dimension d+1
+        // only kill (their own classes are skipped), and the cells above are
+        // skipped entirely; -1 means no limit.
+        void            set_max_dimension(int d)                    { max_dim_ = d; }
+        int             max_dimension() const                       { return max_dim_; }
+
+        // Don't report the pairs (i,j) with value(j) - value(i) < epsilon, where
+        // value maps the indices of the filtration to their values, and mark both
+        // cells skip. This filters the output; it saves no work, since a pair is
+        // only known once its column is reduced. Persistence types without skip
+        // support (e.g., CohomologyPersistence outside a PairRecorder) only lose
+        // the report.
+        void            set_report_threshold(double epsilon, Value value)   { epsilon_ = epsilon; value_ = std::move(value); }
+        double          report_threshold() const                    { return epsilon_; }
+
+        const ReductionStatistics&
+                        statistics() const                          { return statistics_; }
+
+    protected:
+        bool            above(int d) const                          { return max_dim_ >= 0 && d > max_dim_ + 1; }
+        bool            top(int d) const                            { return max_dim_ >= 0 && d == max_dim_ + 1; }
+        bool            filtered(Index i, Index j)                  { if (value_ && value_(j) - value_(i) < epsilon_) { ++statistics_.filtered; return true; } return false; }
+
+    protected:
+        int                     max_dim_ = -1;
+        double                  epsilon_ = 0;
+        Value                   value_;
+        ReductionStatistics     statistics_;
+};
+
+}
+
+template<class C, class F, class Cmp>
+bool
+dionysus::HeapColumn<C,F,Cmp>::
+pivot()
+{
+    while (!heap_.empty())
+    {
+        Entry         top = std::move(heap_.front());
+        FieldElement  e   = top.element();
+        pop();
+        while (!heap_.empty() && !cmp_(heap_.front(), top) && !cmp_(top, heap_.front()))
+        {
+            e = field_.add(e, heap_.front().element());
+            pop();
+        }
+
+        if (!field_.is_zero(e))
+        {
+            top.set_element(e);
+            heap_.emplace_back(std::move(top));
+            std::push_heap(heap_.begin(), heap_.end(), cmp_);
+            return true;
+        }
+    }
+    return false;
+}
+
+template<class C, class F, class Cmp>
+template<class Chain2>
+void
+dionysus::HeapColumn<C,F,Cmp>::
+add_all_but_low(FieldElement a, const Chain2& chain)
+{
+    if (chain.empty())
+        return;
+
+    auto last = std::prev(std::end(chain));
+    for (auto it = std::begin(chain); it != last; ++it)
+    {
+        heap_.emplace_back(field_.mul(a, it->element()), it->index());
+        std::push_heap(heap_.begin(), heap_.end(), cmp_);
+    }
+}
+
+template<class C, class F, class Cmp>
+void
+dionysus::HeapColumn<C,F,Cmp>::
+finalize(Chain& c)
+{
+    c.clear();
+    while (pivot())
+    {
+        c.emplace_back(std::move(heap_.front()));
+        pop();
+    }
+    std::reverse(c.begin(), c.end());
+}
+
+template<class F, class I, class Cmp>
+template<class Chain>
+void
+dionysus::LazyHeapColumn<F,I,Cmp>::
+assign(Chain& c)
+{
+    heap_.clear();
+    for (auto& e : c)
+        heap_.push_back(Entry { Accumulator(detail::normalize(field_, e.element())), e.index() });
+    c.clear();
+    std::make_heap(heap_.begin(), heap_.end(), order());
+}
+
+template<class F, class I, class Cmp>
+bool
+dionysus::LazyHeapColumn<F,I,Cmp>::
+pivot()
+{
+    while (!heap_.empty())
+    {
+        Entry         top   = heap_.front();
+        Accumulator   sum   = top.value;
+        Accumulator   terms = 1;
+        pop();
+        while (!heap_.empty() && !cmp_(heap_.front().i, top.i) && !cmp_(top.i, heap_.front().i))
+        {
+            if (terms == bound_)
+            {
+                sum   = field_.reduce(sum);
+                terms = 1;
+            }
+            sum += heap_.front().value;
+            ++terms;
+            pop();
+        }
+
+        FieldElement e = field_.reduce(sum);
+        if (!field_.is_zero(e))
+        {
+            top.value = e;
+            heap_.push_back(top);
+            std::push_heap(heap_.begin(), heap_.end(), order());
+            return true;
+        }
+    }
+    return false;
+}
+
+template<class F, class I, class Cmp>
+template<class Chain2>
+void
+dionysus::LazyHeapColumn<F,I,Cmp>::
+add_all_but_low(FieldElement a, const Chain2& chain)
+{
+    if (chain.empty())
+        return;
+
+    auto last = std::prev(std::end(chain));
+    for (auto it = std::begin(chain); it != last; ++it)
+    {
+        heap_.push_back(Entry { field_.lazy_mul(a, it->element()), it->index() });
+        std::push_heap(heap_.begin(), heap_.end(), order());
+    }
+}
+
+template<class F, class I, class Cmp>
+template<class Chain>
+void
+dionysus::LazyHeapColumn<F,I,Cmp>::
+finalize(Chain& c)
+{
+    c.clear();
+    while (pivot())
+    {
+        c.emplace_back(element(), index());
+        pop();
+    }
+    std::reverse(c.begin(), c.end());
 }
 
 #endif
@@ -0,0 +1,99 @@
+#ifndef DIONYSUS_RIPS_COHOMOLOGY_H
+#define DIONYSUS_RIPS_COHOMOLOGY_H
+
+#include <vector>
+#include <unordered_map>
+
+#include "chain.h"
+#include "combinatorial-simplex.h"
+
+namespace dionysus
+{
+
+/**
+ * RipsCohomology
+ *
+ * Persistent cohomology of the k-skeleton of the Rips complex, computed without
+ * materializing the filtration (after Bauer's Ripser). The simplices are
+ * CombinatorialSimplices, with their diameter as data, and the coboundaries are
+ * enumerated on the fly from the neighborhoods of the vertices. The dimensions
+ * are processed one at a time, with clearing: only the simplices of the current
+ * dimension are kept, and for every pair, only the combination of the simplices
+ * whose coboundaries were added up to produce it (the reduction column).
+ *
+ * The filtration order is by diameter, then dimension, then code; it is
+ * consistent with Rips::Comparison, so the diagrams match those of
+ * CohomologyPersistence on the sorted filtration (up to ties).
+ *
+ * Distances_ is as in Rips.
+ */
+template<class Field_, class Distances_, class Vertex_ = unsigned>
+class RipsCohomology
+{
+    public:
+        typedef             Field_                                          Field;
+        typedef             Distances_                                      Distances;
+        typedef             Vertex_                                         Vertex;
+        typedef             typename Distances::IndexType                   IndexType;
+        typedef             typename Distances::DistanceType                DistanceType;
+
+        typedef             typename Field::Element                         FieldElement;
+        typedef             CombinatorialSimplex<Vertex, DistanceType>      Simplex;
+        typedef             typename Simplex::Code                          Code;
+        typedef             ChainEntry<Field, Simplex>                      Entry;
+        typedef             std::vector<Entry>                              Chain;
+
+        typedef             short unsigned                                  Dimension;
+
+        // filtration order of the simplices of the same dimension
+        struct              Comparison
+        {
+            bool            operator()(const Simplex& s1, const Simplex& s2) const
+            { return s1.data() < s2.data() || (s1.data() == s2.data() && s1.code() < s2.code()); }
+        };
+
+    public:
+                            RipsCohomology(const Field& field, const Distances& distances):
+                                field_(field), distances_(distances)        {}
+
+        // Calls report_pair(dim, birth, death) for every pair, with birth a dim-simplex and
+        // death a (dim+1)-simplex, and report_essential(dim, birth) for every class that
+        // doesn't die, in dimensions 0..k of the k-skeleton at scale max.
+        template<class ReportPair, class ReportEssential>
+        void                operator()(Dimension k, DistanceType max, const ReportPair& report_pair, const ReportEssential& report_essential);
+
+        const Field&        field() const                                   { return field_; }
+        const Distances&    distances() const                               { return distances_; }
+
+        DistanceType        diameter(const Simplex& s) const;
+
+    private:
+        typedef             std::pair<Vertex, DistanceType>                 Neighbor;
+        typedef             std::vector<std::vector<Neighbor>>              Neighbors;
+        typedef             std::unordered_map<Code, size_t>                Pivots;
+
+        // calls f(coface, element) for every cofacet of s in the complex; only for those
+        // that add a vertex above s's top, if top_only
+        template<class F>
+        void                coboundary(const Simplex& s, bool top_only, const F& f) const;
+
+        template<class ReportPair, class ReportEssential>
+        void                reduce(Dimension d, const std::vector<Simplex>& columns, Pivots& pivots,
+                                   const ReportPair& report_pair, const ReportEssential& report_essential) const;
+
+    private:
+        Field               field_;
+        const Distances&    distances_;
+
+        Vertex              n_   = 0;
+        DistanceType        max_ = 0;
+        Neighbors           neighbors_;         // within max_, in decreasing order
+
+        mutable std::vector<Vertex> vertices_;  // scratch for coboundary()
+};
+
+}
+
+#include "rips-cohomology.hpp"
+
+#endif
@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <stdexcept>
+
+template<class F, class D, class V>
+template<class ReportPair, class ReportEssential>
+void
+dionysus::RipsCohomology<F,D,V>::
+operator()(Dimension k, DistanceType max, const ReportPair& report_pair, const ReportEssential& report_essential)
+{
+    IndexType b = distances_.begin();
+    n_   = distances_.end() - b;
+    max_ = max;
+
+    Simplex::reserve(n_, k + 1);
+    if (Simplex::binomial(n_, k + 1) == BinomialCoefficients::max())
+        throw std::overflow_error("Simplices do not fit into the combinatorial number system");
+
+    // neighborhoods; vertex u is distances' index b + u
+    neighbors_.clear();
+    neighbors_.resize(n_);
+    for (Vertex u = 0; u < n_; ++u)
+        for (Vertex v = n_; v-- > 0;)
+        {
+            if (u == v)
+                continue;
+            DistanceType d = distances_(b + u, b + v);
+            if (d <= max_)
+                neighbors_[u].emplace_back(v, d);
+        }
+
+    std::vector<Simplex> simplices;
+    for (Vertex v = 0; v < n_; ++v)
+        simplices.emplace_back(0, Code(v), DistanceType(0));
+
+    Pivots pivots;
+    for (Dimension d = 0; d <= k; ++d)
+    {
+        // each (d+1)-simplex is the cofacet of its facet without the top vertex
+        std::vector<Simplex> next;
+        if (d < k)
+            for (auto& s : simplices)
+                coboundary(s, true, [&next](Simplex&& t, FieldElement) { next.emplace_back(std::move(t)); });
+
+        // clearing: the pivots of dimension d-1 are already paired
+        simplices.erase(std::remove_if(simplices.begin(), simplices.end(),
+                                       [&pivots](const Simplex& s) { return pivots.count(s.code()); }),
+                        simplices.end());
+        pivots.clear();
+
+        if (d == k)
+        {
+            for (auto& s : simplices)
+                report_essential(d, s);
+            break;
+        }
+
+        Comparison cmp;
+        std::sort(simplices.begin(), simplices.end(), [cmp](const Simplex& s1, const Simplex& s2) { return cmp(s2, s1); });
+        reduce(d, simplices, pivots, report_pair, report_essential);
+
+        simplices.swap(next);
+    }
+
+    neighbors_.clear();
+}
+
+// columns are in decreasing filtration order; the pivot of a cochain is its oldest cofacet
+template<class F, class D, class V>
+template<class ReportPair, class ReportEssential>
+void
+dionysus::RipsCohomology<F,D,V>::
+reduce(Dimension d, const std::vector<Simplex>& columns, Pivots& pivots,
+       const ReportPair& report_pair, const ReportEssential& report_essential) const
+{
+    Comparison cmp;
+    auto heap_cmp = [cmp](const Entry& e1, const Entry& e2) { return cmp(e2.index(), e1.index()); };
+
+    std::vector<Chain>          reductions;
+    std::vector<FieldElement>   pivot_elements;
+
+    Chain   heap, reduction;
+    auto    add_coboundary = [this,&heap,heap_cmp](const Simplex& s, FieldElement m)
+    {
+        coboundary(s, false, [this,&heap,heap_cmp,m](Simplex&& t, FieldElement x)
+        {
+            heap.emplace_back(field_.mul(m, x), std::move(t));
+            std::push_heap(heap.begin(), heap.end(), heap_cmp);
+        });
+    };
+
+    // combines the entries of the oldest simplex in the heap, until their sum is non-zero;
+    // the sum stays in the heap
+    auto    get_pivot = [this,&heap,heap_cmp](Entry& pivot)
+    {
+        while (!heap.empty())
+        {
+            std::pop_heap(heap.begin(), heap.end(), heap_cmp);
+            pivot = std::move(heap.back());
+            heap.pop_back();
+
+            FieldElement x = pivot.element();
+            while (!heap.empty() && heap.front().index().code() == pivot.index().code())
+            {
+                x = field_.add(x, heap.front().element());
+                std::pop_heap(heap.begin(), heap.end(), heap_cmp);
+                heap.pop_back();
+            }
+
+            if (!field_.is_zero(x))
+            {
+                pivot.set_element(x);
+                heap.push_back(pivot);
+                std::push_heap(heap.begin(), heap.end(), heap_cmp);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // sums the entries of the same simplex and drops the zeros, so that a stored
+    // reduction doesn't grow with the history of the additions that produced it
+    auto    consolidate = [this](Chain& c)
+    {
+        std::sort(c.begin(), c.end(), [](const Entry& e1, const Entry& e2) { return e1.index().code() < e2.index().code(); });
+        auto out = c.begin();
+        for (auto it = c.begin(); it != c.end();)
+        {
+            FieldElement x = it->element();
+            auto jt = std::next(it);
+            for (; jt != c.end() && jt->index().code() == it->index().code(); ++jt)
+                x = field_.add(x, jt->element());
+            if (!field_.is_zero(x))
+            {
+                if (out != it)
+                    *out = std::move(*it);
+                out->set_element(x);
+                ++out;
+            }
+            it = jt;
+        }
+        c.erase(out, c.end());
+    };
+
+    for (auto& s : columns)
+    {
+        heap.clear();
+        reduction.clear();
+        reduction.emplace_back(field_.id(), s);
+        add_coboundary(s, field_.id());
+
+        Entry pivot;
+        while (true)
+        {
+            if (!get_pivot(pivot))
+            {
+                report_essential(d, s);
+                break;
+            }
+
+            auto it = pivots.find(pivot.index().code());
+            if (it == pivots.end())
+            {
+                pivots.emplace(pivot.index().code(), reductions.size());
+                consolidate(reduction);
+                reductions.emplace_back(std::move(reduction));
+                pivot_elements.push_back(pivot.element());
+                report_pair(d, s, pivot.index());
+                break;
+            }
+
+            // cancel the pivot with the reduction that owns it
+            const Chain& r = reductions[it->second];
+            FieldElement m = field_.neg(field_.div(pivot.element(), pivot_elements[it->second]));
+            for (auto& e : r)
+            {
+                FieldElement x = field_.mul(m, e.element());
+                reduction.emplace_back(x, e.index());
+                add_coboundary(e.index(), x);
+            }
+        }
+    }
+}
+
+template<class F, class D, class V>
+template<class Functor>
+void
+dionysus::RipsCohomology<F,D,V>::
+coboundary(const Simplex& s, bool top_only, const Functor& f) const
+{
+    Dimension m = s.dimension() + 1;        // number of vertices
+    auto& vertices = vertices_;             // decreasing
+    vertices.assign(s.begin(), s.end());
+
+    // candidates are the neighbors of the vertex with the fewest
+    Vertex u = vertices[0];
+    for (Dimension i = 1; i < m; ++i)
+        if (neighbors_[vertices[i]].size() < neighbors_[u].size())
+            u = vertices[i];
+
+    auto neighbor = [this](Vertex w, Vertex v, DistanceType& d)
+    {
+        auto& nw = neighbors_[w];
+        auto  it = std::lower_bound(nw.begin(), nw.end(), v, [](const Neighbor& x, Vertex v) { return x.first > v; });
+        if (it == nw.end() || it->first != v)
+            return false;
+        d = it->second;
+        return true;
+    };
+
+    // as in CombinatorialSimplex::CoboundaryChainIterator
+    Code    below = s.code(),
+            above = 0;
+    int     k     = m;                      // number of s's vertices below v
+    Dimension next = 0;
+    for (auto& x : neighbors_[u])
+    {
+        Vertex v = x.first;
+        if (top_only && v < vertices[0])
+            break;
+
+        while (next < m && vertices[next] > v)
+        {
+            below -= Simplex::binomial(vertices[next], k);
+            above += Simplex::binomial(vertices[next], k + 1);
+            --k; ++next;
+        }
+        if (next < m && vertices[next] == v)
+            continue;
+
+        DistanceType diameter = std::max(s.data(), x.second);
+        bool         clique   = true;
+        for (Dimension i = 0; i < m && clique; ++i)
+        {
+            DistanceType d;
+            if (vertices[i] == u)
+                continue;
+            if ((clique = neighbor(vertices[i], v, d)))
+                diameter = std::max(diameter, d);
+        }
+        if (!clique)
+            continue;
+
+        Code code = above + Simplex::binomial(v, k + 1) + below;
+        f(Simplex(m, code, diameter), (k % 2 == 0) ? field_.id() : field_.neg(field_.id()));
+    }
+}
+
+template<class F, class D, class V>
+typename dionysus::RipsCohomology<F,D,V>::DistanceType
+dionysus::RipsCohomology<F,D,V>::
+diameter(const Simplex& s) const
+{
+    IndexType    b  = distances_.begin();
+    DistanceType mx = 0;
+    for (auto it = s.begin(); it != s.end(); ++it)
+        for (auto jt = std::next(it); jt != s.end(); ++jt)
+            mx = std::max(mx, distances_(b + *it, b + *jt));
+    return mx;
+}
@@ -7,8 +7,7 @@ void
 dionysus::RowReduction<F,I,C,V...>::
 operator()(const Filtration& filtration, const ReportPair& report_pair)
 {
-    using Cell = typename Filtration::Cell;
-    (*this)(filtration, [](const Cell&) { return false; }, report_pair, &no_progress);
+    (*this)(filtration, NoRelative(), report_pair, &no_progress);
 }
 
 template<class F, typename I, class C, template<class Self> class... V>
@@ -23,7 +22,7 @@ operator()(const Filtration& filtration, const Relative& relative, const ReportP
     typedef     typename Persistence::FieldElement              Element;
     typedef     typename Persistence::Chain                     Chain;
     typedef     typename Filtration::Cell                       Cell;
-    typedef     ChainEntry<Field, Cell>                         CellChainEntry;
+    typedef     CellBoundaryEntry<Cell, Field>                  CellChainEntry;
     typedef     ChainEntry<Field, Index>                        ChainEntry;
 
     std::vector<Chain>      rows(persistence_.size());
@@ -43,7 +42,7 @@ operator()(const Filtration& filtration, const Relative& relative, const ReportP
             continue;
         }
 
-        persistence_.set(i, c.boundary(field) |
+        persistence_.set(i, cell_boundary(c, field) |
                                        ba::filtered([relative](const CellChainEntry& e) { return !relative(e.index()); }) |
                                        ba::transformed([this,&filtration,i](const CellChainEntry& e)
                                        { return ChainEntry(e.element(), filtration.index(e.index(), i)); }));
@@ -3,6 +3,8 @@
 
 #include <algorithm>
 #include <functional>
+#include <memory>
+#include <type_traits>
 
 //#include <boost/compressed_pair.hpp>
 #include <boost/range/iterator_range.hpp>
@@ -16,21 +18,75 @@ namespace dionysus
 
 struct Empty {};
 
-template<class Vertex_ = unsigned, class T = Empty>
+namespace detail
+{
+
+// Vertex storage for Simplex: up to N vertices live inline (no allocation),
+// larger simplices fall back to the heap. The size is tracked by the owner.
+template<class Vertex, unsigned N, bool = (N > 0) && std::is_trivial<Vertex>::value>
+struct SimplexVertices
+{
+    typedef     std::unique_ptr<Vertex[]>   Vertices;
+
+    static bool     is_inline(size_t n)                     { return n <= N; }
+
+    Vertex*         allocate(size_t n)                      { if (!is_inline(n)) heap_ = new Vertex[n]; return get(n); }
+    void            release(size_t n)                       { if (!is_inline(n)) delete[] heap_; }
+    void            adopt(Vertices&& v, size_t n)           { if (is_inline(n)) std::copy(v.get(), v.get() + n, inline_); else heap_ = v.release(); }
+    void            steal(SimplexVertices& other, size_t n) { if (is_inline(n)) std::copy(other.inline_, other.inline_ + n, inline_); else { heap_ = other.heap_; other.heap_ = nullptr; } }
+
+    Vertex*         get(size_t n)                           { return is_inline(n) ? inline_ : heap_; }
+    const Vertex*   get(size_t n) const                     { return is_inline(n) ? inline_ : heap_; }
+
+    union
+    {
+        Vertex*     heap_ = nullptr;
+        Vertex      inline_[N];
+    };
+};
+
+// Non-trivial vertex types (e.g., std::vector<int> in the Freudenthal triangulation) always live on the heap
+template<class Vertex, unsigned N>
+struct SimplexVertices<Vertex, N, false>
+{
+    typedef     std::unique_ptr<Vertex[]>   Vertices;
+
+    Vertex*         allocate(size_t n)                      { heap_ = new Vertex[n]; return heap_; }
+    void            release(size_t)                         { delete[] heap_; }
+    void            adopt(Vertices&& v, size_t)             { heap_ = v.release(); }
+    void            steal(SimplexVertices& other, size_t)   { heap_ = other.heap_; other.heap_ = nullptr; }
+
+    Vertex*         get(size_t)                             { return heap_; }
+    const Vertex*   get(size_t) const                       { return heap_; }
+
+    Vertex*         heap_ = nullptr;
+};
+
+}
+
+// N is the number of vertices stored inline, without a heap allocation;
+// the default covers everything up to tetrahedra.
+template<class Vertex_ = unsigned, class T = Empty, unsigned N = 4>
 class Simplex
 {
     public:
         typedef         Vertex_                                     Vertex;
         typedef         T                                           Data;
         typedef         std::unique_ptr<Vertex[]>                   Vertices;
+        typedef         detail::SimplexVertices<Vertex, N>          VertexStorage;
 
         template<class Field>
         struct BoundaryChainIterator;
         struct BoundaryIterator;
+        struct Face;
+        template<class Field>
+        struct FaceChainIterator;
 
         template<class Field>
         using BoundaryChainRange = boost::iterator_range<BoundaryChainIterator<Field>>;
         using BoundaryRange      = boost::iterator_range<BoundaryIterator>;
+        template<class Field>
+        using FaceChainRange     = boost::iterator_range<FaceChainIterator<Field>>;
 
         template<class Field>
         using Entry = ChainEntry<Field, Simplex>;
@@ -49,7 +105,7 @@ class Simplex
                             Simplex(vertices.size() - 1, vertices.begin(), vertices.end(), d)   {}
 
                         Simplex(short unsigned dim, Vertices&& vertices, Data&& data = Data()):
-                            dim_(dim), vertices_(std::move(vertices)), data_(std::move(data))   { std::sort(begin(), end()); }
+                            dim_(dim), data_(std::move(data))       { vertices_.adopt(std::move(vertices), size()); std::sort(begin(), end()); }
 
         template<class VertexRange>
                         Simplex(const VertexRange& vertices,
@@ -64,29 +120,28 @@ class Simplex
 
                         Simplex(const Simplex& other):
                             Simplex(other.dim_, other.begin(), other.end(), other.data_)        {}
-        Simplex&        operator=(const Simplex& other)             { dim_ = other.dim_; vertices_ = Vertices(new Vertex[dim_+1]); std::copy(other.begin(), other.end(), begin()); data_ = other.data_; return *this; }
+        Simplex&        operator=(const Simplex& other)             { if (this == &other) return *this; vertices_.release(size()); dim_ = other.dim_; vertices_.allocate(size()); std::copy(other.begin(), other.end(), begin()); data_ = other.data_; return *this; }
 
                         Simplex(Simplex&& other) noexcept:
                             dim_(other.dim_),
-                            vertices_(std::move(other.vertices_)),
-                            data_(std::move(other.data_))           {}
-        Simplex&        operator=(Simplex&& other)                  = default;
+                            data_(std::move(other.data_))           { vertices_.steal(other.vertices_, size()); }
+        Simplex&        operator=(Simplex&& other) noexcept         { if (this == &other) return *this; vertices_.release(size()); dim_ = other.dim_; vertices_.steal(other.vertices_, size()); data_ = std::move(other.data_); return *this; }
+
+                        ~Simplex()                                  { vertices_.release(size()); }
 
         template<class Iterator>
                         Simplex(short unsigned dim,
                                 Iterator b, Iterator e,
                                 Data&& d = Data()):
                             dim_(dim),
-                            vertices_(new Vertex[dim_+1]),
-                            data_(std::move(d))                     { std::copy(b, e, begin()); std::sort(begin(), end()); }
+                            data_(std::move(d))                     { vertices_.allocate(size()); std::copy(b, e, begin()); std::sort(begin(), end()); }
 
         template<class Iterator>
                         Simplex(short unsigned dim,
                                 Iterator b, Iterator e,
                                 const Data& d):
                             dim_(dim),
-                            vertices_(new Vertex[dim_+1]),
-                            data_(d)                                { std::copy(b, e, begin()); std::sort(begin(), end()); }
+                            data_(d)                                { vertices_.allocate(size()); std::copy(b, e, begin()); std::sort(begin(), end()); }
 
         short unsigned  dimension() const                           { return dim_; }
 
@@ -105,14 +160,28 @@ class Simplex
         BoundaryChainIterator<Field>
                         boundary_end(const Field& field) const;
 
-        const Vertex*   begin() const                               { return vertices_.get(); }
-        const Vertex*   end() const                                 { return begin() + dim_ + 1; }
-        size_t          size() const                                { return dim_ + 1; }
+        // Same as boundary(field), but the entries are Face views into this simplex, rather than new simplices
+        template<class Field>
+        FaceChainRange<Field>
+                        faces(const Field& field) const             { return FaceChainRange<Field>(faces_begin(field), faces_end(field)); }
+
+        template<class Field>
+        FaceChainIterator<Field>
+                        faces_begin(const Field& field) const       { return FaceChainIterator<Field>(field, boundary_begin()); }
+        template<class Field>
+        FaceChainIterator<Field>
+                        faces_end(const Field& field) const         { return FaceChainIterator<Field>(field, boundary_end()); }
+
+        Face            face(short unsigned i) const                { return Face(begin(), dimension(), i); }     // face opposite vertex i
+
+        const Vertex*   begin() const                               { return vertices_.get(size()); }
+        const Vertex*   end() const                                 { return begin() + size(); }
+        size_t          size() const                                { return static_cast<short unsigned>(dim_ + 1); }      // 0 for the empty simplex
 
         std::pair<const Vertex*, const Vertex*>
                         range() const                               { return std::make_pair(begin(), end()); }
 
-        Simplex         join(const Vertex& v) const                 { Vertices vertices(new Vertex[dim_+2]); std::copy(begin(), end(), vertices.get()); vertices[dim_+1] = v; return Simplex(dim_ + 1, std::move(vertices), Data(data_)); }
+        Simplex         join(const Vertex& v) const                 { Simplex s(data_); s.dim_ = dim_ + 1; Vertex* vertices = s.vertices_.allocate(s.size()); std::copy(begin(), end(), vertices); vertices[dim_+1] = v; std::sort(s.begin(), s.end()); return s; }
         bool            contains(const Vertex& v) const             { return std::find(begin(), end(), v) != end(); }
 
         bool            operator==(const Simplex& other) const      { return dim_ == other.dim_ && std::equal(begin(), end(), other.begin()); }
@@ -120,7 +189,7 @@ class Simplex
         bool            operator<(const Simplex& other) const       { return dim_ < other.dim_ || (dim_ == other.dim_ && std::lexicographical_compare(begin(), end(), other.begin(), other.end())); }
         bool            operator>(const Simplex& other) const       { return other < (*this); }
 
-        Vertex          operator[](short unsigned i) const          { return vertices_[i]; }
+        Vertex          operator[](short unsigned i) const          { return begin()[i]; }
         const Data&     data() const                                { return data_; }
         Data&           data()                                      { return data_; }
 
@@ -129,31 +198,88 @@ class Simplex
         { out << '<' << *s.begin(); for (auto it = s.begin() + 1; it != s.end(); ++it) out << ',' << *it; out << '>'; return out; }
 
     private:
-        Vertex*         begin()                                     { return vertices_.get(); }
-        Vertex*         end()                                       { return begin() + dim_ + 1; }
+        Vertex*         begin()                                     { return vertices_.get(size()); }
+        Vertex*         end()                                       { return begin() + size(); }
 
     private:
+        VertexStorage       vertices_;      // first, so that dim_ and data_ pack into its tail
         short unsigned      dim_;
         //boost::compressed_pair<Vertices, Data>      vertices_data_;
-        Vertices            vertices_;
         Data                data_;          // TODO: optimize
 };
 
-template<class V, class D>
-size_t hash_value(const Simplex<V,D>& s)                            { return boost::hash_range(s.begin(), s.end()); }
+template<class V, class D, unsigned N>
+size_t hash_value(const Simplex<V,D,N>& s)                          { return boost::hash_range(s.begin(), s.end()); }
+
+
+// Lightweight view of a codimension-1 face: parent's vertices with one of them omitted.
+// Hashes and compares equal to the Simplex it represents, so it can be looked up
+// in a Filtration without materializing the face. The parent must outlive the view.
+template<class V, class D, unsigned N>
+struct Simplex<V,D,N>::Face
+{
+    public:
+        typedef     Simplex<V,D,N>                                          Parent;
+
+        struct iterator:
+            public boost::iterator_adaptor<iterator, const V*, const V, boost::forward_traversal_tag>
+        {
+                        iterator()                                          {}
+                        iterator(const V* it, const V* skip):
+                            iterator::iterator_adaptor_(it == skip ? it + 1 : it), skip_(skip)    {}
+
+            private:
+                friend class    boost::iterator_core_access;
+                void            increment()                                 { if (++this->base_reference() == skip_) ++this->base_reference(); }
+
+                const V*        skip_ = nullptr;
+        };
+        typedef     iterator                                                const_iterator;
+
+                    Face(const V* vertices, short unsigned parent_dim, short unsigned omitted):
+                        vertices_(vertices), dim_(parent_dim - 1), omitted_(omitted)   {}
+
+        short unsigned  dimension() const                                   { return dim_; }
+        size_t          size() const                                        { return dim_ + 1; }
+        short unsigned  omitted() const                                     { return omitted_; }
+
+        iterator        begin() const                                       { return iterator(vertices_, vertices_ + omitted_); }
+        iterator        end() const                                         { return iterator(vertices_ + dim_ + 2, vertices_ + omitted_); }
+
+        V               operator[](short unsigned i) const                  { return vertices_[i < omitted_ ? i : i + 1]; }
 
+        Parent          simplex() const                                     { return Parent(dim_, begin(), end()); }
+                        operator Parent() const                             { return simplex(); }
 
-template<class V, class D>
-struct Simplex<V,D>::BoundaryIterator:
+        friend bool     operator==(const Face& f, const Parent& s)          { return f.dim_ == s.dimension() && std::equal(f.begin(), f.end(), s.begin()); }
+        friend bool     operator==(const Parent& s, const Face& f)          { return f == s; }
+        friend bool     operator!=(const Face& f, const Parent& s)          { return !(f == s); }
+        friend bool     operator!=(const Parent& s, const Face& f)          { return !(f == s); }
+
+        friend size_t   hash_value(const Face& f)                           { return boost::hash_range(f.begin(), f.end()); }
+
+        friend
+        std::ostream&   operator<<(std::ostream& out, const Face& f)
+        { out << '<' << *f.begin(); for (auto it = std::next(f.begin()); it != f.end(); ++it) out << ',' << *it; out << '>'; return out; }
+
+    private:
+        const V*        vertices_;
+        short unsigned  dim_;
+        short unsigned  omitted_;
+};
+
+
+template<class V, class D, unsigned N>
+struct Simplex<V,D,N>::BoundaryIterator:
     public boost::iterator_adaptor<BoundaryIterator,    // Derived
                                    const V*,            // Base
-                                   Simplex<V,D>,        // Value
+                                   Simplex<V,D,N>,      // Value
                                    boost::use_default,
-                                   Simplex<V,D>>        // Reference
+                                   Simplex<V,D,N>>      // Reference
 {
     public:
         typedef     const V*                            Iterator;
-        typedef     Simplex<V,D>                        Value;
+        typedef     Simplex<V,D,N>                      Value;
 
         typedef     boost::iterator_adaptor<BoundaryIterator,
                                             Iterator,
@@ -166,37 +292,30 @@ struct Simplex<V,D>::BoundaryIterator:
                         Parent(iter), dim_(dim), bg_(bg), end_(end)         {}
 
         Iterator    begin() const                                           { return bg_; }
+        Face        face() const                                            { return Face(bg_, dim_, this->base() - bg_); }
 
     private:
         friend class    boost::iterator_core_access;
-        Value    dereference() const
-        {
-            typedef     std::not_equal_to<V>                                NotEqualVertex;
-
-            using std::placeholders::_1;
-            return      Simplex(dim_ - 1,
-                                boost::make_filter_iterator(std::bind(NotEqualVertex(), _1, *(this->base())), bg_,  end_),
-                                boost::make_filter_iterator(std::bind(NotEqualVertex(), _1, *(this->base())), end_, end_));
-        }
+        Value    dereference() const                                        { return face().simplex(); }
 
         short unsigned  dim_;
         Iterator        bg_;
         Iterator        end_;
 };
 
-template<class V, class D>
+template<class V, class D, unsigned N>
 template<class F>
-struct Simplex<V,D>::BoundaryChainIterator:
+struct Simplex<V,D,N>::BoundaryChainIterator:
     public boost::iterator_adaptor<BoundaryChainIterator<F>,              // Derived
                                    BoundaryIterator,
-                                   ChainEntry<F,Simplex<V,D>>,    // Value
+                                   ChainEntry<F,Simplex<V,D,N>>,  // Value
                                    boost::use_default,
-                                   ChainEntry<F,Simplex<V,D>>>    // Reference
+                                   ChainEntry<F,Simplex<V,D,N>>>  // Reference
 {
     public:
         typedef     F                                                       Field;
         typedef     BoundaryIterator                                        Iterator;
-        typedef     ChainEntry<F,Simplex<V,D>>                              Value;
+        typedef     ChainEntry<F,Simplex<V,D,N>>                            Value;
 
         typedef     boost::iterator_adaptor<BoundaryChainIterator,
                                             Iterator,
@@ -219,47 +338,82 @@ struct Simplex<V,D>::BoundaryChainIterator:
         const Field*    field_ = nullptr;
 };
 
+template<class V, class D, unsigned N>
+template<class F>
+struct Simplex<V,D,N>::FaceChainIterator:
+    public boost::iterator_adaptor<FaceChainIterator<F>,                  // Derived
+                                   BoundaryIterator,
+                                   ChainEntry<F,Face>,                    // Value
+                                   boost::use_default,
+                                   ChainEntry<F,Face>>                    // Reference
+{
+    public:
+        typedef     F                                                       Field;
+        typedef     BoundaryIterator                                        Iterator;
+        typedef     ChainEntry<F,Face>                                      Value;
+
+        typedef     boost::iterator_adaptor<FaceChainIterator,
+                                            Iterator,
+                                            Value,
+                                            boost::use_default,
+                                            Value>                          Parent;
+
+                    FaceChainIterator()                                     {}
+        explicit    FaceChainIterator(const Field& field, Iterator iter):
+                        Parent(iter), field_(&field)                        {}
+
+    private:
+        friend class    boost::iterator_core_access;
+        Value    dereference() const
+        {
+            return      Value(((this->base().base() - this->base().begin()) % 2 == 0)? field_->id() : field_->neg(field_->id()),
+                              this->base().face());
+        }
+
+        const Field*    field_ = nullptr;
+};
+
 
 /* Simplex */
-template<class V, class D>
-typename Simplex<V,D>::BoundaryIterator
-Simplex<V,D>::
+template<class V, class D, unsigned N>
+typename Simplex<V,D,N>::BoundaryIterator
+Simplex<V,D,N>::
 boundary_begin() const
 {
     if (dimension() == 0)   return boundary_end();
     return BoundaryIterator(dimension(), begin(), begin(), end());
 }
 
-template<class V, class D>
-typename Simplex<V,D>::BoundaryIterator
-Simplex<V,D>::
+template<class V, class D, unsigned N>
+typename Simplex<V,D,N>::BoundaryIterator
+Simplex<V,D,N>::
 boundary_end() const
 {
     return BoundaryIterator(dimension(), end(), begin(), end());
 }
 
-template<class V, class D>
+template<class V, class D, unsigned N>
 template<class F>
 #if defined(_MSC_VER)
-typename Simplex<V,D>::BoundaryChainIterator<F>
+typename Simplex<V,D,N>::BoundaryChainIterator<F>
 #else
-typename Simplex<V,D>::template BoundaryChainIterator<F>
+typename Simplex<V,D,N>::template BoundaryChainIterator<F>
 #endif
-Simplex<V,D>::
+Simplex<V,D,N>::
 boundary_begin(const F& field) const
 {
     if (dimension() == 0)   return boundary_end(field);
     return BoundaryChainIterator<F>(field, boundary_begin());
 }
 
-template<class V, class D>
+template<class V, class D, unsigned N>
 template<class F>
 #if defined(_MSC_VER)
-typename Simplex<V,D>::BoundaryChainIterator<F>
+typename Simplex<V,D,N>::BoundaryChainIterator<F>
 #else
-typename Simplex<V,D>::template BoundaryChainIterator<F>
+typename Simplex<V,D,N>::template BoundaryChainIterator<F>
 #endif
-Simplex<V,D>::
+Simplex<V,D,N>::
 boundary_end(const F& field) const
 {
     return BoundaryChainIterator<F>(field, boundary_end());
@@ -270,10 +424,10 @@ boundary_end(const F& field) const
 namespace std
 {
 
-template<class V, class T>
-struct hash<dionysus::Simplex<V,T>>
+template<class V, class T, unsigned N>
+struct hash<dionysus::Simplex<V,T,N>>
 {
-    size_t operator()(const dionysus::Simplex<V,T>& s) const            { return hash_value(s); }
+    size_t operator()(const dionysus::Simplex<V,T,N>& s) const          { return hash_value(s); }
 };
 
 } // std
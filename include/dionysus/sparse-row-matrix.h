@@ -3,7 +3,7 @@
 
 #include <vector>
 #include <list>
-#include <unordered_map>
+#include <deque>
 #include <iostream>         // for debugging output
 
 #include <boost/intrusive/list.hpp>
@@ -45,6 +45,11 @@ namespace detail
     };
 }
 
+// The rows and the columns are addressed by slots: small non-negative integers,
+// which the caller allocates (and recycles), so the storage is dense: deques of
+// rows and columns (so that the references to them stay valid as they grow)
+// and a vector of lows, indexed by the slots. The rows are ordered by their
+// keys (set_key()), the ids that the slots stand for, with Comparison.
 template<class Field_, class Index_ = int, class Comparison_ = std::less<Index_>,
          template<class E, class... Args> class Column_ = std::vector>
 class SparseRowMatrix
@@ -63,9 +68,9 @@ class SparseRowMatrix
 
         typedef         std::vector<ChainEntry<Field, Index>>                   IndexChain;
 
-        typedef         std::unordered_map<Index, Column>                       Columns;
-        typedef         std::unordered_map<Index, Row>                          Rows;
-        typedef         std::unordered_map<Index, Index>                        LowMap;
+        typedef         std::deque<Column>                                      Columns;
+        typedef         std::deque<Row>                                         Rows;
+        typedef         std::vector<Index>                                      Indices;
 
     public:
                         SparseRowMatrix(const Field&        field,
@@ -84,45 +89,54 @@ class SparseRowMatrix
 
         const Row&      prepend_row(Index r, FieldElement m, const Row& chain); // could be horribly inefficient if Column is chosen poorly
 
-        void            drop_row(Index r)                                       { rows_.erase(r); if (is_low(r)) lows_.erase(r); }
+        void            drop_row(Index r)                                       { row(r).clear(); if (is_low(r)) drop_low(r); }
         void            drop_col(Index c)
         {
-            auto cit = columns_.find(c);
-            Column& column = cit->second;
+            Column& column = col(c);
             if (!column.empty())
             {
                 Index rlow = std::get<0>(column.back().index());
-                auto it = lows_.find(rlow);
-                if (it != lows_.end() && it->second == c)
-                    lows_.erase(it);
+                if (is_low(rlow) && low(rlow) == c)
+                    drop_low(rlow);
             }
-            columns_.erase(cit);
+            Column().swap(column);          // the entries unlink themselves from the rows
+            exists_[c] = false;
+            --size_;
         }
-        void            drop_low(Index r)                                       { lows_.erase(r); }
+        void            drop_low(Index r)                                       { lows_[r] = unpaired(); }
 
         // accessors
-        Row&            row(Index r)                                            { return rows_[r]; }
-        Column&         col(Index c)                                            { assert(col_exists(c)); return columns_.find(c)->second; }
-        const Column&   col(Index c) const                                      { assert(col_exists(c)); return columns_.find(c)->second; }
-        Index           low(Index r) const                                      { return lows_.find(r)->second; }
-        bool            is_low(Index r) const                                   { return lows_.find(r) != lows_.end(); }
-        void            update_low(Index c)                                     { lows_[std::get<0>(col(c).back().index())] = c; }
+        Row&            row(Index r)                                            { return grow(rows_, r); }
+        Column&         col(Index c)                                            { assert(col_exists(c)); return columns_[c]; }
+        const Column&   col(Index c) const                                      { assert(col_exists(c)); return columns_[c]; }
+        Index           low(Index r) const                                      { return lows_[r]; }
+        bool            is_low(Index r) const                                   { return r < Index(lows_.size()) && lows_[r] != unpaired(); }
+        void            update_low(Index c)                                     { grow(lows_, std::get<0>(col(c).back().index()), unpaired()) = c; }
+
+        // the keys order the rows
+        void            set_key(Index r, Index k)                               { grow(keys_, r) = k; }
+        Index           key(Index r) const                                      { return keys_[r]; }
+        bool            row_less(Index r1, Index r2) const                      { return cmp_(keys_[r1], keys_[r2]); }
 
         const Field&        field() const                                       { return field_; }
         void                reserve(size_t)                                     {}                              // here for compatibility only
         const Comparison&   cmp() const                                         { return cmp_; }
 
+        size_t          size() const                                            { return size_; }              // number of columns
+        static Index    unpaired()                                              { return Reduction<Index>::unpaired; }
+
         // debug
-        bool            col_exists(Index c) const                               { return columns_.find(c) != columns_.end(); }
+        bool            col_exists(Index c) const                               { return c < Index(exists_.size()) && exists_[c]; }
         const Columns&  columns() const                                         { return columns_; }
         void            check_columns() const
         {
-            for (auto& x : columns_)
+            for (Index c = 0; c < Index(columns_.size()); ++c)
             {
-                Index c  = x.first;
-                if (x.second.empty())
+                if (!col_exists(c))
+                    continue;
+                if (col(c).empty())
                     std::cout << "Warning: empty column " << c << std::endl;
-                Index rl = std::get<0>(x.second.back().index());
+                Index rl = std::get<0>(col(c).back().index());
                 if (!is_low(rl) || low(rl) != c)
                 {
                     std::cout << "Columns don't check out: lows don't match" << std::endl;
@@ -135,30 +149,44 @@ class SparseRowMatrix
                         std::cout << "   " << x.element() << ' ' << std::get<0>(x.index()) << ' ' << std::get<1>(x.index()) << '\n';
                     assert(0);
                 }
+            }
 
-                for (auto& x : lows_)
+            for (Index r = 0; r < Index(lows_.size()); ++r)
+            {
+                if (!is_low(r))
+                    continue;
+                if (!col_exists(low(r)))
                 {
-                    if (!col_exists(x.second))
-                    {
-                        std::cout << "Still keeping low of a removed column" << std::endl;
-                        assert(0);
-                    }
-                    else if (std::get<0>(col(x.second).back().index()) != x.first)
-                    {
-                        std::cout << "Low mismatch: " << x.second << ' ' << std::get<0>(col(x.second).back().index()) << ' ' << x.first << '\n';
-                        assert(0);
-                    }
+                    std::cout << "Still keeping low of a removed column" << std::endl;
+                    assert(0);
+                }
+                else if (std::get<0>(col(low(r)).back().index()) != r)
+                {
+                    std::cout << "Low mismatch: " << low(r) << ' ' << std::get<0>(col(low(r)).back().index()) << ' ' << r << '\n';
+                    assert(0);
                 }
             }
         }
 
+    private:
+        template<class Container, class... Value>
+        static auto     grow(Container& c, Index i, const Value&... x) -> decltype(c[i])
+        {
+            if (i >= Index(c.size()))
+                c.resize(i + 1, x...);
+            return c[i];
+        }
+
     private:
         Field           field_;
         Comparison      cmp_;
 
         Columns         columns_;
+        std::vector<char>   exists_;
+        size_t          size_ = 0;
         Rows            rows_;
-        LowMap          lows_;          // column that has this low
+        Indices         lows_;          // column that has this low
+        Indices         keys_;          // id of the row
 };
 
 
@@ -5,7 +5,7 @@ dionysus::SparseRowMatrix<F,I,C,Col>::
 reduce(const ChainRange& chain_, IndexChain& trail)
 {
     auto    row_cmp = [this](const Entry& e1, const Entry& e2)
-                      { return this->cmp_(std::get<0>(e1.index()), std::get<0>(e2.index())); };
+                      { return this->row_less(std::get<0>(e1.index()), std::get<0>(e2.index())); };
 
 #define __DIONYSUS_USE_VECTOR_CHAINS    1
 
@@ -26,15 +26,15 @@ reduce(const ChainRange& chain_, IndexChain& trail)
     auto      lows     = [this](const IndexPair& rc) -> IndexPair
                          {
                              Index r  = std::get<0>(rc);
-                             auto  it = this->lows_.find(r);
-                             if (it == this->lows_.end())
+                             if (!this->is_low(r))
                                  return ReductionIP::unpaired;
                              else
                              {
-                                 Index rr = std::get<0>(col(it->second).back().index());
+                                 Index c  = this->low(r);
+                                 Index rr = std::get<0>(col(c).back().index());
                                  if (rr != r)
                                      std::cout << "Mismatch: " << rr << ' ' << r << std::endl;
-                                 return IndexPair(r, it->second);
+                                 return IndexPair(r, c);
                              }
                          };
 
@@ -56,7 +56,9 @@ typename dionysus::SparseRowMatrix<F,I,C,Col>::Index
 dionysus::SparseRowMatrix<F,I,C,Col>::
 set(Index col, Column&& chain)
 {
-    Column& column = columns_.emplace(col, std::move(chain)).first->second;
+    Column& column = grow(columns_, col) = std::move(chain);
+    grow(exists_, col) = true;
+    ++size_;
 
     fix(col, column);
 
@@ -66,7 +68,7 @@ set(Index col, Column&& chain)
         res = low(r);
     else
         res = col;
-    lows_[r] = col;
+    grow(lows_, r, unpaired()) = col;
 
     return res;
 }
@@ -1,12 +1,42 @@
 #ifndef DIONYSUS_STANDARD_REDUCTION_H
 #define DIONYSUS_STANDARD_REDUCTION_H
 
+#include <vector>
+#include <type_traits>
+
+#include "reduction.h"
+#include "chain.h"
+
 namespace dionysus
 {
 
+namespace detail
+{
+    // whether Persistence can be filled out of order, and knows its positive columns (like ReducedMatrix)
+    template<class Persistence, class = void>
+    struct Clears: std::false_type {};
+
+    template<class Persistence>
+    struct Clears<Persistence, decltype(std::declval<Persistence&>().positive(typename Persistence::Index()), void())>: std::true_type {};
+
+    // whether Persistence can add a cell that only kills (like CohomologyPersistence)
+    template<class Persistence, class = void>
+    struct Kills: std::false_type {};
+
+    template<class Persistence>
+    struct Kills<Persistence, decltype(std::declval<Persistence&>().kill(std::vector<ChainEntry<typename Persistence::Field, typename Persistence::Index>>()), void())>: std::true_type {};
+
+    // whether Persistence can mark cells skip (like ReducedMatrix and PairRecorder)
+    template<class Persistence, class = void>
+    struct Skips: std::false_type {};
+
+    template<class Persistence>
+    struct Skips<Persistence, decltype(std::declval<Persistence&>().set_skip(typename Persistence::Index()), void())>: std::true_type {};
+}
+
 // Mid-level interface
 template<class Persistence_>
-class StandardReduction
+class StandardReduction: public ReductionOptions<typename Persistence_::Index>
 {
     public:
         typedef         Persistence_                                Persistence;
@@ -29,12 +59,41 @@ class StandardReduction
         static void     no_report_pair(int, Index, Index)           {}
         static void     no_progress()                               {}
 
+        // twist: sweep the filtration once per dimension, from the top, so that the
+        // columns of the cells that become pivots are zeroed without reduction
+        // (see ReducedMatrix::positive()); the pairs are reported in the order they're found.
+        // Ignored by persistence types that can't take columns out of order.
+        void            set_clearing(bool flag = true)              { clearing_ = flag; }
+        bool            clearing() const                            { return clearing_; }
+
         const Persistence&
                         persistence() const                         { return persistence_; }
         Persistence&    persistence()                               { return persistence_; }
 
+    private:
+        // the cells of dimension max_dimension() + 1
+        template<class ChainRange>
+        Index           kill(Index, const ChainRange& chain, std::true_type)   { return persistence_.kill(chain); }
+
+        template<class ChainRange>
+        Index           kill(Index i, const ChainRange& chain, std::false_type);
+
+        // only for persistence types that can mark cells skip
+        void            set_skip(Index i, std::true_type)           { persistence_.set_skip(i); }
+        void            set_skip(Index, std::false_type)            {}
+
+        template<class ReportPair>
+        void            report(const ReportPair& report_pair, int d, Index i, Index j);
+
+        template<class Filtration, class Relative, class ReportPair, class Progress>
+        bool            twist(const Filtration& f, const Relative& relative, const ReportPair& report_pair, const Progress& progress, std::true_type);
+
+        template<class Filtration, class Relative, class ReportPair, class Progress>
+        bool            twist(const Filtration&, const Relative&, const ReportPair&, const Progress&, std::false_type)    { return false; }
+
     private:
         Persistence&    persistence_;
+        bool            clearing_ = false;
 };
 
 }
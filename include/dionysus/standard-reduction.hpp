@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <boost/range/adaptors.hpp>
 namespace ba = boost::adaptors;
 
@@ -7,8 +9,7 @@ void
 dionysus::StandardReduction<P>::
 operator()(const Filtration& filtration, const ReportPair& report_pair)
 {
-    using Cell = typename Filtration::Cell;
-    (*this)(filtration, [](const Cell&) { return false; }, report_pair, no_progress);
+    (*this)(filtration, NoRelative(), report_pair, no_progress);
 }
 
 template<class P>
@@ -17,10 +18,15 @@ void
 dionysus::StandardReduction<P>::
 operator()(const Filtration& filtration, const Relative& relative, const ReportPair& report_pair, const Progress& progress)
 {
+    this->statistics_ = ReductionStatistics();
+
+    if (clearing_ && twist(filtration, relative, report_pair, progress, detail::Clears<P>()))
+        return;
+
     persistence_.reserve(filtration.size());
 
     typedef     typename Filtration::Cell                       Cell;
-    typedef     ChainEntry<Field, Cell>                         CellChainEntry;
+    typedef     CellBoundaryEntry<Cell, Field>                  CellChainEntry;
     typedef     ChainEntry<Field, Index>                        ChainEntry;
 
     unsigned i = 0;
@@ -28,20 +34,128 @@ operator()(const Filtration& filtration, const Relative& relative, const ReportP
     {
         progress();
 
-        if (relative(c))
+        bool rel = relative(c);
+        if (rel || this->above(c.dimension()))
         {
+            if (!rel)
+                ++this->statistics_.skipped;
             ++i;
             persistence_.add_skip();
             continue;
         }
 
         //std::cout << "Adding: " << c << " : " << boost::distance(c.boundary(persistence_.field())) << std::endl;
-        Index pair = persistence_.add(c.boundary(persistence_.field()) |
-                                                 ba::filtered([relative](const CellChainEntry& e) { return !relative(e.index()); }) |
-                                                 ba::transformed([this,&filtration,i](const CellChainEntry& e)
-                                                 { return ChainEntry(e.element(), filtration.index(e.index(), i)); }));
+        auto boundary = cell_boundary(c, persistence_.field()) |
+                        ba::filtered([relative](const CellChainEntry& e) { return !relative(e.index()); }) |
+                        ba::transformed([this,&filtration,i](const CellChainEntry& e)
+                        { return ChainEntry(e.element(), filtration.index(e.index(), i)); });
+        Index pair = this->top(c.dimension()) ? kill(i, boundary, detail::Kills<P>()) : persistence_.add(boundary);
+        ++this->statistics_.reduced;
         if (pair != persistence_.unpaired())
-            report_pair(c.dimension(), pair, i);
+            report(report_pair, c.dimension(), pair, i);
         ++i;
     }
 }
+
+template<class P>
+template<class ChainRange>
+typename dionysus::StandardReduction<P>::Index
+dionysus::StandardReduction<P>::
+kill(Index i, const ChainRange& chain, std::false_type)
+{
+    Index pair = persistence_.add(chain);
+    if (pair == persistence_.unpaired())
+        set_skip(i, detail::Skips<P>());        // its class is above the maximum dimension
+    return pair;
+}
+
+template<class P>
+template<class ReportPair>
+void
+dionysus::StandardReduction<P>::
+report(const ReportPair& report_pair, int d, Index i, Index j)
+{
+    if (this->filtered(i, j))
+    {
+        set_skip(i, detail::Skips<P>());
+        set_skip(j, detail::Skips<P>());
+        return;
+    }
+    report_pair(d, i, j);
+}
+
+template<class P>
+template<class Filtration, class Relative, class ReportPair, class Progress>
+bool
+dionysus::StandardReduction<P>::
+twist(const Filtration& filtration, const Relative& relative, const ReportPair& report_pair, const Progress& progress, std::true_type)
+{
+    persistence_.resize(filtration.size());
+
+    typedef     typename Filtration::Cell                       Cell;
+    typedef     CellBoundaryEntry<Cell, Field>                  CellChainEntry;
+    typedef     ChainEntry<Field, Index>                        ChainEntry;
+
+    int max_dim = -1;
+    for (auto& c : filtration)
+        max_dim = std::max<int>(max_dim, c.dimension());
+
+    if (this->above(max_dim))
+    {
+        Index i = 0;
+        for (auto& c : filtration)
+        {
+            if (this->above(c.dimension()))
+            {
+                persistence_.set_skip(i);
+                if (!relative(c))
+                    ++this->statistics_.skipped;
+            }
+            ++i;
+        }
+        max_dim = this->max_dimension() + 1;
+    }
+
+    for (int d = max_dim; d >= 0; --d)
+    {
+        Index i = 0;
+        for (auto& c : filtration)
+        {
+            if (c.dimension() != d)
+            {
+                ++i;
+                continue;
+            }
+
+            progress();
+
+            if (relative(c))
+            {
+                persistence_.set_skip(i++);
+                continue;
+            }
+
+            if (persistence_.positive(i))       // cleared
+            {
+                persistence_.clear_positive(i);
+                ++this->statistics_.cleared;
+                ++i;
+                continue;
+            }
+
+            persistence_.set(i, cell_boundary(c, persistence_.field()) |
+                                ba::filtered([relative](const CellChainEntry& e) { return !relative(e.index()); }) |
+                                ba::transformed([this,&filtration,i](const CellChainEntry& e)
+                                { return ChainEntry(e.element(), filtration.index(e.index(), i)); }));
+
+            Index pair = persistence_.reduce(i);
+            ++this->statistics_.reduced;
+            if (pair != persistence_.unpaired())
+                report(report_pair, c.dimension(), pair, i);
+            else if (this->top(d))
+                persistence_.set_skip(i);       // its class is above the maximum dimension
+            ++i;
+        }
+    }
+    return true;
+}
@@ -17,6 +17,9 @@ struct MatrixV
         template<class Chain>
         void        chain_initialized(Self* r, Index i, Chain& c)           { v_[i].emplace_back(r->field().id(), i); }
 
+        // R_j has pivot i and D R_j = 0, so V_i = R_j keeps R = DV (with R_i = 0) and V upper-triangular
+        void        column_cleared(Self* r, Index i, Index j)               { v_[i] = typename Self::Chain((*r)[j]); }
+
         void        addto(Self* r, Index i, typename Field::Element m, Index o)
         {
             Chain<typename Self::Chain>::addto(v_[i], m, v_[o], r->field(), entry_cmp);
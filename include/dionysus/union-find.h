@@ -0,0 +1,62 @@
+#ifndef DIONYSUS_UNION_FIND_H
+#define DIONYSUS_UNION_FIND_H
+
+#include <vector>
+#include <utility>
+
+namespace dionysus
+{
+
+// Disjoint sets of 0..size()-1, with path compression and union by rank
+template<class Index_ = unsigned>
+class UnionFind
+{
+    public:
+        typedef         Index_                                      Index;
+
+    public:
+                        UnionFind(size_t n = 0)                     { resize(n); }
+
+        // new singleton set
+        Index           add()                                       { parent_.push_back(parent_.size()); rank_.push_back(0); return parent_.size() - 1; }
+        void            resize(size_t n)
+        {
+            for (size_t i = parent_.size(); i < n; ++i)
+                parent_.push_back(i);
+            rank_.resize(n, 0);
+        }
+        size_t          size() const                                { return parent_.size(); }
+
+        Index           find(Index i)
+        {
+            Index root = i;
+            while (parent_[root] != root)
+                root = parent_[root];
+            while (parent_[i] != root)
+            {
+                Index next = parent_[i];
+                parent_[i] = root;
+                i = next;
+            }
+            return root;
+        }
+
+        // merges the sets of two roots; returns the root of the union
+        Index           unite(Index i, Index j)
+        {
+            if (rank_[i] < rank_[j])
+                std::swap(i,j);
+            parent_[j] = i;
+            if (rank_[i] == rank_[j])
+                ++rank_[i];
+            return i;
+        }
+
+    private:
+        std::vector<Index>          parent_;
+        std::vector<unsigned char>  rank_;
+};
+
+}
+
+#endif
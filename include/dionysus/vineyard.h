@@ -0,0 +1,108 @@
+#ifndef DIONYSUS_VINEYARD_H
+#define DIONYSUS_VINEYARD_H
+
+#include <vector>
+
+#include "trails-chains.h"
+#include "diagram.h"
+
+namespace dionysus
+{
+
+/**
+ * Vineyard
+ *
+ * Maintains the decomposition R = DV of a filtration (taken over from a reduced
+ * OrdinaryPersistenceWithV) under transpositions of adjacent cells, following
+ * Cohen-Steiner, Edelsbrunner, Morozov, "Vines and vineyards by updating
+ * persistence in linear time" (generalized to any field): each transposition
+ * costs at most a couple of column additions.
+ *
+ * Cells keep the ids they had in the original filtration, and R, V, and the
+ * pairs are indexed by (and their entries are) cell ids, so a transposition
+ * only updates the positions (cell(i), position(c)) and the columns it
+ * operates on; their entries are put in order when they are added to. Every
+ * pair (and every unpaired cell) belongs to a vine, which follows the point of
+ * the diagram continuously through the transpositions (vine(c)).
+ */
+template<class Field_, typename Index_ = unsigned>
+class Vineyard
+{
+    public:
+        typedef         Field_                                      Field;
+        typedef         Index_                                      Index;
+        typedef         OrdinaryPersistenceWithV<Field, Index>      Persistence;
+
+        typedef         typename Field::Element                     FieldElement;
+        typedef         typename Persistence::Entry                 Entry;
+        typedef         typename Persistence::Chain                 Chain;
+        typedef         typename Persistence::Chains                Chains;
+        typedef         std::vector<Index>                          Indices;
+        typedef         short unsigned                              Dimension;
+        typedef         std::vector<Dimension>                      Dimensions;
+
+    public:
+        // persistence must be fully reduced, in order (e.g., by StandardReduction)
+        template<class Filtration>
+                        Vineyard(Persistence&& persistence, const Filtration& filtration);
+                        Vineyard(Persistence&& persistence, Dimensions dimensions);
+
+        // Swap the cells at positions i and i+1; the cell at i must not be a face of
+        // the cell at i+1. Returns whether their pairs switched.
+        bool            transpose(Index i);
+
+        // Move to the order where order[k] is the id of the cell at position k, by
+        // transpositions (as many as there are inversions); every intermediate order
+        // is a filtration, if both ends are. Calls report(i, switched) after every
+        // transposition; returns the number of switches.
+        template<class Report>
+        size_t          reorder(const Indices& order, const Report& report);
+        size_t          reorder(const Indices& order)               { return reorder(order, [](Index, bool) {}); }
+
+        // Diagrams of the current order, with value(c) the value of the cell with id c;
+        // the data of every point is its vine.
+        template<class GetValue>
+        auto            diagrams(const GetValue& value) const
+            -> std::vector<Diagram<decltype(value(Index())), Index>>;
+
+        size_t          size() const                                { return pairs_.size(); }
+        const Field&    field() const                               { return field_; }
+
+        // by cell id; the entries of the chains are not necessarily in order
+        const Chain&    operator[](Index c) const                   { return r_[c]; }
+        const Chain&    v(Index c) const                            { return v_[c]; }
+        Index           pair(Index c) const                         { return pairs_[c]; }
+        bool            skip(Index c) const                         { return skip_[c]; }
+        Dimension       dimension(Index c) const                    { return dimensions_[c]; }
+        Index           vine(Index c) const                         { return vines_[c]; }
+
+        Index           cell(Index i) const                         { return cells_[i]; }
+        Index           position(Index c) const                     { return positions_[c]; }
+
+        static const Index unpaired()                               { return Reduction<Index>::unpaired; }
+
+    private:
+        Index           low(Index c) const;
+        FieldElement    entry(const Chain& chain, Index c) const;
+
+        // column j += m * column k, in both R and V
+        void            add(Index j, FieldElement m, Index k);
+        void            sort(Chain& chain) const;
+
+    private:
+        Field           field_;
+        Chains          r_, v_;
+        Indices         pairs_;
+        std::vector<char> skip_;
+        Dimensions      dimensions_;
+
+        Indices         cells_;             // position -> cell id
+        Indices         positions_;         // cell id  -> position
+        Indices         vines_;
+};
+
+}
+
+#include "vineyard.hpp"
+
+#endif
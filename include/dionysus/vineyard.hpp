@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <limits>
+
+template<class F, typename I>
+dionysus::Vineyard<F,I>::
+Vineyard(Persistence&& persistence, Dimensions dimensions):
+    field_(persistence.field()),
+    dimensions_(std::move(dimensions))
+{
+    Index n = persistence.size();
+    for (Index i = 0; i < n; ++i)
+    {
+        r_.emplace_back(std::move(persistence.column(i)));
+        pairs_.push_back(persistence.pair(i));
+        skip_.push_back(persistence.skip(i));
+        cells_.push_back(i);
+        positions_.push_back(i);
+        vines_.push_back(std::min(i, pairs_[i]));           // the positive cell of the pair
+    }
+    v_ = std::move(persistence.template visitor<0>().v_);
+}
+
+template<class F, typename I>
+template<class Filtration>
+dionysus::Vineyard<F,I>::
+Vineyard(Persistence&& persistence, const Filtration& filtration):
+    Vineyard(std::move(persistence), Dimensions())
+{
+    for (auto& c : filtration)
+        dimensions_.push_back(c.dimension());
+}
+
+template<class F, typename I>
+bool
+dionysus::Vineyard<F,I>::
+transpose(Index i)
+{
+    Index s = cells_[i],
+          t = cells_[i+1];
+
+    Index s_pair = pairs_[s],
+          t_pair = pairs_[t];
+    Index s_vine = vines_[s],
+          t_vine = vines_[t];
+
+    if (dimensions_[s] == dimensions_[t])
+    {
+        // zero out V[s,t], so that V stays upper-triangular after the swap
+        FieldElement c = entry(v_[t], s);
+        if (!field_.is_zero(c))
+        {
+            FieldElement m = field_.neg(field_.div(c, entry(v_[s], s)));
+            if (!r_[s].empty() && (r_[t].empty() || positions_[low(s)] > positions_[low(t)]))
+            {
+                // the sum has s's pivot: it becomes t's column, and t's old column becomes s's
+                Chain r = r_[t], v = v_[t];
+                add(t, m, s);
+                r_[s] = std::move(r);
+                v_[s] = std::move(v);
+            } else
+                add(t, m, s);
+        }
+
+        // both positive: if the pair of t contains s, it would get s's pivot after the swap
+        Index k = s_pair, l = t_pair;
+        if (r_[s].empty() && r_[t].empty() && k != unpaired() && l != unpaired())
+        {
+            FieldElement x = entry(r_[l], s);
+            if (!field_.is_zero(x))
+            {
+                if (positions_[k] < positions_[l])
+                    add(l, field_.neg(field_.div(x, entry(r_[k], s))), k);
+                else
+                    add(k, field_.neg(field_.div(entry(r_[k], s), x)), l);
+            }
+        }
+    }
+
+    std::swap(cells_[i], cells_[i+1]);
+    positions_[s] = i + 1;
+    positions_[t] = i;
+
+    // only the pairs of s, t, and their partners can change
+    Index affected[4] = { s, t, s_pair, t_pair };
+    for (Index a : affected)
+        if (a != unpaired())
+            pairs_[a] = unpaired();
+
+    for (Index a : affected)
+    {
+        if (a == unpaired())
+            continue;
+        Index l = low(a);
+        if (l != unpaired())
+        {
+            pairs_[a] = l;
+            pairs_[l] = a;
+        }
+    }
+
+    if (pairs_[s] == s_pair)
+        return false;
+
+    // the pairs switched: the vines follow the cells that stayed put
+    Index sv = pairs_[s] == unpaired() ? unpaired() : vines_[pairs_[s]],
+          tv = pairs_[t] == unpaired() ? unpaired() : vines_[pairs_[t]];
+    if (sv == unpaired())
+        sv = (tv == s_vine ? t_vine : s_vine);
+    if (tv == unpaired())
+        tv = (sv == s_vine ? t_vine : s_vine);
+    vines_[s] = sv;
+    vines_[t] = tv;
+
+    return true;
+}
+
+template<class F, typename I>
+template<class Report>
+size_t
+dionysus::Vineyard<F,I>::
+reorder(const Indices& order, const Report& report)
+{
+    // bring the cells into place one by one; the cells they pass are all out of order
+    size_t switches = 0;
+    for (Index k = 0; k < order.size(); ++k)
+        for (Index p = positions_[order[k]]; p > k; --p)
+        {
+            bool switched = transpose(p - 1);
+            switches += switched;
+            report(p - 1, switched);
+        }
+    return switches;
+}
+
+template<class F, typename I>
+template<class GetValue>
+auto
+dionysus::Vineyard<F,I>::
+diagrams(const GetValue& value) const
+    -> std::vector<Diagram<decltype(value(Index())), Index>>
+{
+    using Value = decltype(value(Index()));
+
+    std::vector<Diagram<Value, Index>> result;
+    for (Index c : cells_)
+    {
+        if (skip_[c])
+            continue;
+
+        Dimension d = dimensions_[c];
+        while (d + 1 > result.size())
+            result.emplace_back();
+
+        Index p = pairs_[c];
+        if (p == unpaired())
+            result[d].emplace_back(value(c), std::numeric_limits<Value>::infinity(), vines_[c]);
+        else if (positions_[p] > positions_[c])
+        {
+            Value birth = value(c),
+                  death = value(p);
+            if (birth != death)         // skip diagonal
+                result[d].emplace_back(birth, death, vines_[c]);
+        }
+    }
+
+    return result;
+}
+
+// the youngest cell in the boundary of c
+template<class F, typename I>
+typename dionysus::Vineyard<F,I>::Index
+dionysus::Vineyard<F,I>::
+low(Index c) const
+{
+    Index l = unpaired();
+    for (auto& e : r_[c])
+        if (l == unpaired() || positions_[e.index()] > positions_[l])
+            l = e.index();
+    return l;
+}
+
+template<class F, typename I>
+typename dionysus::Vineyard<F,I>::FieldElement
+dionysus::Vineyard<F,I>::
+entry(const Chain& chain, Index c) const
+{
+    for (auto& e : chain)
+        if (e.index() == c)
+            return e.element();
+    return field_.zero();
+}
+
+template<class F, typename I>
+void
+dionysus::Vineyard<F,I>::
+add(Index j, FieldElement m, Index k)
+{
+    auto entry_cmp = [this](const Entry& e1, const Entry& e2) { return positions_[e1.index()] < positions_[e2.index()]; };
+    for (Index c : { j, k })
+    {
+        sort(r_[c]);
+        sort(v_[c]);
+    }
+    dionysus::Chain<Chain>::addto(r_[j], m, r_[k], field_, entry_cmp);
+    dionysus::Chain<Chain>::addto(v_[j], m, v_[k], field_, entry_cmp);
+}
+
+// the transpositions leave the chains almost in order, so insertion sort
+template<class F, typename I>
+void
+dionysus::Vineyard<F,I>::
+sort(Chain& chain) const
+{
+    for (size_t x = 1; x < chain.size(); ++x)
+        for (size_t y = x; y > 0 && positions_[chain[y].index()] < positions_[chain[y-1].index()]; --y)
+            std::swap(chain[y], chain[y-1]);
+}
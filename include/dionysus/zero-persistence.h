@@ -0,0 +1,212 @@
+#ifndef DIONYSUS_ZERO_PERSISTENCE_H
+#define DIONYSUS_ZERO_PERSISTENCE_H
+
+#include <vector>
+#include <tuple>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "reduction.h"
+#include "chain.h"
+#include "diagram.h"
+#include "union-find.h"
+
+namespace dionysus
+{
+
+// 0-dimensional persistence, in near-linear time, without a boundary matrix:
+// the components are tracked with UnionFind, and when an edge merges two of
+// them, the younger one (whose oldest vertex comes later) dies (the elder rule).
+// Works on the vertices and edges of a filtration; the remaining cells, and
+// the edges that don't merge components (they create cycles), are skipped.
+// The pairs are the same as those of the 0-dimensional homology reductions.
+template<class Index_ = unsigned>
+class ZeroPersistence
+{
+    public:
+        typedef         Index_                                      Index;
+
+    public:
+        template<class Filtration, class ReportPair, class Progress>
+        void            operator()(const Filtration& f, const ReportPair& report_pair, const Progress& progress);
+
+        template<class Filtration, class ReportPair>
+        void            operator()(const Filtration& f, const ReportPair& report_pair)  { (*this)(f, report_pair, &no_progress); }
+
+        template<class Filtration>
+        void            operator()(const Filtration& f)             { (*this)(f, &no_report_pair); }
+
+        static void     no_report_pair(int, Index, Index)           {}
+        static void     no_progress()                               {}
+
+        size_t          size() const                                { return pairs_.size(); }
+        Index           pair(Index i) const                         { return pairs_[i]; }
+        bool            skip(Index i) const                         { return skip_[i]; }
+        static const Index unpaired()                               { return Reduction<Index>::unpaired; }
+
+    private:
+        std::vector<Index>      pairs_;
+        std::vector<char>       skip_;
+};
+
+template<class I>
+template<class Filtration, class ReportPair, class Progress>
+void
+ZeroPersistence<I>::
+operator()(const Filtration& filtration, const ReportPair& report_pair, const Progress& progress)
+{
+    Index n = filtration.size();
+    pairs_.assign(n, unpaired());
+    skip_.assign(n, false);
+
+    // the sets are over the cell indices; only the vertices are ever used
+    UnionFind<Index>    components(n);
+    std::vector<Index>  oldest(n);
+
+    Z2Field k;
+    for (Index i = 0; i < n; ++i)
+    {
+        progress();
+        const auto& c = filtration[i];
+        if (c.dimension() == 0)
+        {
+            oldest[i] = i;
+            continue;
+        } else if (c.dimension() > 1)
+        {
+            skip_[i] = true;
+            continue;
+        }
+
+        Index v[2], j = 0;
+        for (auto&& x : cell_boundary(c, k))
+        {
+            if (j == 2)
+                throw std::runtime_error("ZeroPersistence: an edge must have two vertices");
+            v[j++] = filtration.index(x.index(), i);
+        }
+        if (j != 2)
+            throw std::runtime_error("ZeroPersistence: an edge must have two vertices");
+
+        Index r0 = components.find(v[0]),
+              r1 = components.find(v[1]);
+        if (r0 == r1)
+        {
+            skip_[i] = true;        // a cycle
+            continue;
+        }
+
+        Index younger = std::max(oldest[r0], oldest[r1]),
+              elder   = std::min(oldest[r0], oldest[r1]);
+        pairs_[younger] = i;
+        pairs_[i]       = younger;
+        report_pair(0, younger, i);
+
+        oldest[components.unite(r0, r1)] = elder;
+    }
+}
+
+
+// 0-dimensional persistence diagram of a graph on vertices 0..n-1, born at
+// births[v], with the given edges (u, v, value); an edge appears no earlier
+// than its vertices. Kruskal's algorithm, with the elder rule (ties broken by
+// vertex index). The data of every point is the vertex that's born; diagonal
+// points are skipped.
+template<class Value, class Vertex>
+Diagram<Value, Vertex>
+zero_persistence(const std::vector<Value>& births, std::vector<std::tuple<Vertex, Vertex, Value>> edges)
+{
+    typedef     std::tuple<Vertex, Vertex, Value>               Edge;
+
+    for (auto& e : edges)
+        std::get<2>(e) = std::max(std::get<2>(e), std::max(births[std::get<0>(e)], births[std::get<1>(e)]));
+    std::sort(edges.begin(), edges.end(), [](const Edge& e1, const Edge& e2) { return std::get<2>(e1) < std::get<2>(e2); });
+
+    auto younger = [&births](Vertex u, Vertex v) { return births[u] > births[v] || (births[u] == births[v] && u > v); };
+
+    Vertex              n = births.size();
+    UnionFind<Vertex>   components(n);
+    std::vector<Vertex> oldest(n);
+    for (Vertex v = 0; v < n; ++v)
+        oldest[v] = v;
+
+    Diagram<Value, Vertex> diagram;
+    for (auto& e : edges)
+    {
+        Vertex r0 = components.find(std::get<0>(e)),
+               r1 = components.find(std::get<1>(e));
+        if (r0 == r1)
+            continue;
+
+        Vertex o0 = oldest[r0],
+               o1 = oldest[r1];
+        if (younger(o0, o1))
+            std::swap(o0, o1);
+
+        if (births[o1] != std::get<2>(e))
+            diagram.emplace_back(births[o1], std::get<2>(e), o1);
+        oldest[components.unite(r0, r1)] = o0;
+    }
+
+    for (Vertex v = 0; v < n; ++v)
+        if (components.find(v) == v)
+            diagram.emplace_back(births[oldest[v]], std::numeric_limits<Value>::infinity(), oldest[v]);
+
+    return diagram;
+}
+
+// 0-dimensional persistence diagram of the Rips complex (up to scale max), from
+// its minimum spanning forest (Prim's algorithm on the complete graph, in
+// O(n^2) time and O(n) space); Distances is as in Rips.
+template<class Distances>
+Diagram<typename Distances::DistanceType, typename Distances::IndexType>
+rips_zero_persistence(const Distances& distances,
+                      typename Distances::DistanceType max = std::numeric_limits<typename Distances::DistanceType>::max())
+{
+    typedef     typename Distances::IndexType                   IndexType;
+    typedef     typename Distances::DistanceType                DistanceType;
+    typedef     std::tuple<IndexType, IndexType, DistanceType>  Edge;
+
+    IndexType    b = distances.begin();
+    IndexType    n = distances.end() - b;
+
+    std::vector<DistanceType>   best(n);
+    std::vector<IndexType>      from(n);
+    std::vector<char>           reached(n, false),
+                                done(n, false);
+    std::vector<Edge>           forest;
+    for (IndexType i = 0; i < n; ++i)
+    {
+        IndexType v = n;
+        for (IndexType w = 0; w < n; ++w)
+            if (!done[w] && (v == n || (reached[w] && (!reached[v] || best[w] < best[v]))))
+                v = w;
+
+        done[v] = true;
+        if (reached[v])
+            forest.emplace_back(from[v], v, best[v]);       // otherwise, v starts a new tree
+
+        for (IndexType w = 0; w < n; ++w)
+        {
+            if (done[w])
+                continue;
+            DistanceType d = distances(b + v, b + w);
+            if (d <= max && (!reached[w] || d < best[w]))
+            {
+                best[w]    = d;
+                from[w]    = v;
+                reached[w] = true;
+            }
+        }
+    }
+
+    auto diagram = zero_persistence(std::vector<DistanceType>(n, 0), std::move(forest));
+    for (auto& p : diagram)
+        p.data += b;
+    return diagram;
+}
+
+}
+
+#endif
@@ -4,17 +4,20 @@
 #include <tuple>
 #include <type_traits>
 #include <deque>
-
-#include <boost/range/adaptor/filtered.hpp>
-#include <boost/range/adaptor/map.hpp>
+#include <vector>
+#include <unordered_map>
 
 #include "sparse-row-matrix.h"
+#include "parallel.h"
 
 namespace dionysus
 {
 
-namespace ba = boost::adaptors;
-
+// The cells and the cycles are identified by ids that keep growing (cell ids
+// in the order of add(), cycle ids outward from 0, in both directions). Inside,
+// the matrices address them by slots that get recycled, so their storage stays
+// as large as the current complex; the rows are ordered by the ids. The public
+// interface takes and returns ids.
 template<class Field_, class Index_ = int, class Comparison_ = std::less<Index_>>
 class ZigzagPersistence
 {
@@ -36,7 +39,8 @@ class ZigzagPersistence
         typedef         typename DequeRowMatrix::Column             DequeColumn;
         typedef         typename DequeRowMatrix::Row                DequeRow;
 
-        typedef         std::unordered_map<Index, Index>            BirthIndexMap;
+        typedef         std::vector<Index>                          Indices;
+        typedef         std::unordered_map<Index, Index>            SlotMap;
 
 
                         ZigzagPersistence(const Field&      field,
@@ -45,8 +49,7 @@ class ZigzagPersistence
                             operations(0),
                             cell_indices(0),
                             z_indicies_last(0),
-                            z_indicies_first(-1),
-                            b_indices(0)                            {}
+                            z_indicies_first(-1)                    {}
 
         template<class ChainRange>
         Index           add(const ChainRange& chain)                // returns the id of the dying cycle (or unpaired)
@@ -70,22 +73,21 @@ class ZigzagPersistence
             return res;
         }
 
-        struct IsAlive
-        {
-                    IsAlive(const ZigzagPersistence& zz_): zz(&zz_)      {}
-            bool    operator()(const std::pair<Index,Index>& x) const   { return zz->is_alive(x.first); }
-            const   ZigzagPersistence*  zz;
-        };
-
-        bool                is_alive(Index x) const                 { return !B.is_low(x); }
+        // Batches of cells, added (removed) in the given order, one operation per cell:
+        // the results are those of the sequence of add() (remove()) calls. The runs of
+        // added cells whose boundaries don't involve each other get their boundaries
+        // reduced by Z up front, in threads threads (0 means all available); none of
+        // the cycles born in a run can take part in these reductions.
+        template<class ChainRanges>
+        Indices         add_batch(const ChainRanges& chains, unsigned threads = 1);
+        Indices         remove_batch(const Indices& cells);
 
-        auto                alive_ops() const -> decltype(BirthIndexMap() | ba::filtered(IsAlive(*this)) | ba::map_values)
-        { return birth_index | ba::filtered(IsAlive(*this)) | ba::map_values; }
+        bool                is_alive(Index x) const                 { return is_alive_slot(z_slots.find(x)->second); }
 
-        auto                alive_cycles() const -> decltype(BirthIndexMap() | ba::filtered(IsAlive(*this)) | ba::map_keys)
-        { return birth_index | ba::filtered(IsAlive(*this)) | ba::map_keys; }
+        Indices             alive_ops() const;                      // the operations that gave birth to the alive cycles
+        Indices             alive_cycles() const;                   // ids of the alive cycles
 
-        size_t              alive_size() const                      { return Z.columns().size() - B.columns().size(); }
+        size_t              alive_size() const                      { return Z.size() - B.size(); }
 
         void                reserve(size_t)                         {}              // here for compatibility only
         const Field&        field() const                           { return Z.field(); }
@@ -99,7 +101,7 @@ class ZigzagPersistence
         static
         const Index     unpaired()                                  { return Reduction<Index>::unpaired; }
 
-        const Column&   cycle(Index i) const                        { return Z.col(i); }
+        Column          cycle(Index i) const;                       // the rows are the cell ids
 
         // debug
         void            check_b_cols() const;
@@ -122,17 +124,34 @@ class ZigzagPersistence
     private:
         template<class ChainRange>
         Index           add_impl(const ChainRange& chain);
+        Index           add_cycles(const IndexChain& cycles);       // adds the cell whose boundary is Z*cycles
         Index           remove_impl(Index cell);
 
+        bool            is_alive_slot(Index z) const                { return Z.col_exists(z) && !B.is_low(z); }
+
+        // cell slots are the rows of Z and C, cycle slots are the columns of Z and the rows of B,
+        // boundary slots are the columns of B and C
+        Index           new_cell(Index id);
+        Index           new_cycle(Index id, Index op);
+        Index           new_boundary();
+        void            free_cell(Index c)                          { cell_slots.erase(Z.key(c)); cell_free.push_back(c); }
+        void            free_cycle(Index z)                         { z_slots.erase(B.key(z)); z_free.push_back(z); }
+        void            free_boundary(Index b)                      { b_free.push_back(b); }
+
+        static Index    new_slot(Indices& free, Index& end);
+
     private:
         RowMatrix       Z, C;
         DequeRowMatrix  B;
 
-        BirthIndexMap   birth_index;
+        Indices         birth_index;                                // cycle slot -> operation
         Index           operations;
         Index           cell_indices;
         Index           z_indicies_last, z_indicies_first;
-        Index           b_indices;
+
+        SlotMap         cell_slots, z_slots;                        // id -> slot
+        Indices         cell_free, z_free, b_free;
+        Index           cell_end = 0, z_end = 0, b_end = 0;
 };
 
 }
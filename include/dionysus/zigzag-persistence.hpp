@@ -7,36 +7,47 @@ dionysus::ZigzagPersistence<F,I,C>::
 add_impl(const ChainRange& chain_)
 {
     //std::cout << "add(" << cell_indices << ")" << std::endl;
-    Index op = operations++;
+    IndexChain cells;       // chain_ in terms of the cell slots
+    for (auto x : chain_)
+        cells.emplace_back(x.element(), cell_slots.find(x.index())->second);
 
     IndexChain cycles;      // chain_ -> Z*cycles
-    Column     z_remainder = Z.reduce(chain_, cycles);
+    Column     z_remainder = Z.reduce(cells, cycles);
     assert(z_remainder.empty());
 
+    return add_cycles(cycles);
+}
+
+template<class F, class I, class C>
+typename dionysus::ZigzagPersistence<F,I,C>::Index
+dionysus::ZigzagPersistence<F,I,C>::
+add_cycles(const IndexChain& cycles)
+{
+    Index op = operations++;
+
     IndexChain  boundaries;
     DequeColumn b_remainder = B.reduce(cycles, boundaries);
 
     // add up columns of C indexed by boundaries
     typedef     typename Column::value_type             Entry;
     auto        row_cmp = [this](const Entry& e1, const Entry& e2)
-                          { return this->cmp()(row(e1), row(e2)); };
+                          { return this->Z.row_less(row(e1), row(e2)); };
     Column      chain;
     for (auto& x : boundaries)
         Chain<Column>::addto(chain, x.element(), C.col(x.index()), field(), row_cmp);
-    chain.push_back(Entry(field().neg(field().id()), IndexPair(cell_indices++,0)));
+    chain.push_back(Entry(field().neg(field().id()), IndexPair(new_cell(cell_indices++),0)));
 
     if (b_remainder.empty())        // birth
     {
         //std::cout << "  birth" << std::endl;
-        Index z_col = z_indicies_last++;
+        Index z_col = new_cycle(z_indicies_last++, op);
         Z.set(z_col, std::move(chain));
-        birth_index[z_col] = op;
         return unpaired();
     }
     else                            // death
     {
         //std::cout << "  death" << std::endl;
-        Index b_col = b_indices++;
+        Index b_col = new_boundary();
         Index pair  = row(b_remainder.back());
         B.set(b_col, std::move(b_remainder));
         C.set(b_col, std::move(chain));
@@ -44,21 +55,95 @@ add_impl(const ChainRange& chain_)
     }
 }
 
+template<class F, class I, class C>
+template<class ChainRanges>
+typename dionysus::ZigzagPersistence<F,I,C>::Indices
+dionysus::ZigzagPersistence<F,I,C>::
+add_batch(const ChainRanges& chains, unsigned threads)
+{
+    Indices res;
+    auto it = std::begin(chains), end = std::end(chains);
+    while (it != end)
+    {
+        // the run ends at the first chain that involves one of its cells (their ids start at first)
+        Index                   first = cell_indices;
+        std::vector<IndexChain> run;
+        for (; it != end; ++it)
+        {
+            IndexChain  cells;
+            bool        independent = true;
+            for (auto x : *it)
+            {
+                if (x.index() >= first)
+                {
+                    independent = false;
+                    break;
+                }
+                cells.emplace_back(x.element(), cell_slots.find(x.index())->second);
+            }
+            if (!independent)
+                break;
+            run.push_back(std::move(cells));
+        }
+        assert(!run.empty());
+
+        // Z only changes by the births in the run, and their cycles have lows below all of these chains
+        std::vector<IndexChain> cycles(run.size());
+        parallel_for(run.size(), threads, [this,&run,&cycles](size_t b, size_t e)
+        {
+            for (size_t k = b; k < e; ++k)
+            {
+                Column z_remainder = Z.reduce(run[k], cycles[k]);
+                assert(z_remainder.empty());
+            }
+        });
+
+        for (auto& z : cycles)
+            res.push_back(add_cycles(z));
+    }
+
+#ifdef DIONYSUS_ZIGZAG_DEBUG
+    check_sorted();
+    check_b_cols();
+    Z.check_columns();
+#endif
+    return res;
+}
+
+template<class F, class I, class C>
+typename dionysus::ZigzagPersistence<F,I,C>::Indices
+dionysus::ZigzagPersistence<F,I,C>::
+remove_batch(const Indices& cells)
+{
+    // every removal rewrites the rows the next one reads, so they go one by one
+    Indices res;
+    for (Index c : cells)
+        res.push_back(remove_impl(c));
+
+#ifdef DIONYSUS_ZIGZAG_DEBUG
+    check_sorted();
+    check_b_cols();
+    Z.check_columns();
+#endif
+    return res;
+}
+
 template<class F, class I, class C>
 typename dionysus::ZigzagPersistence<F,I,C>::Index
 dionysus::ZigzagPersistence<F,I,C>::
-remove_impl(Index cell)
+remove_impl(Index cell_id)
 {
-    //std::cout << "remove(" << cell << ")" << std::endl;
+    //std::cout << "remove(" << cell_id << ")" << std::endl;
 
     Index   op    = operations++;
+    Index   cell  = cell_slots.find(cell_id)->second;
 
     typedef     typename Column::value_type             Entry;
     auto        row_cmp = [this](const Entry& e1, const Entry& e2)
-                          { return this->cmp()(row(e1), row(e2)); };
+                          { return this->Z.row_less(row(e1), row(e2)); };
     typedef     typename DequeColumn::value_type        DequeEntry;
     auto        b_row_cmp = [this](const DequeEntry& e1, const DequeEntry& e2)
-                            { return this->cmp()(row(e1), row(e2)); };
+                            { return this->B.row_less(row(e1), row(e2)); };
 
     IndexChain  z_row;
     for (auto& x : Z.row(cell))
@@ -86,9 +171,8 @@ remove_impl(Index cell)
         //    std::cout << x.element() << ' ' << row(x) << std::endl;
 
         // 1: prepend the cycle
-        Index   znew        = z_indicies_first--;
+        Index   znew        = new_cycle(z_indicies_first--, op);
         Index   oth         = Z.set(znew, std::move(cycle));        // oth records our collision (used in step 6)
-        birth_index[znew]   = op;
 
         //std::cout << "znew oth: " << znew << ' ' << oth << std::endl;
         //std::cout << "oth column:" << std::endl;
@@ -142,12 +226,14 @@ remove_impl(Index cell)
         B.drop_row(l);
         Index Zl_low = row(Z.col(l).back());
         Z.drop_col(l);
-        birth_index.erase(l);
+        free_cycle(l);
         C.drop_col(j);
+        free_boundary(j);
         assert(Z.row(cell).empty());
         assert(C.row(cell).empty());
         C.drop_row(cell);
         Z.drop_row(cell);
+        free_cell(cell);
         //std::cout << "Done with step 5" << std::endl;
         if (oth == l)       // we just dropped our collision in Z
             oth = znew;
@@ -182,7 +268,7 @@ remove_impl(Index cell)
                 oth = Z.low(low);
             //std::cout << "--- -- new low: " << low << ' ' << cur << ' ' << oth << std::endl;
 
-            if (cmp()(oth, cur))
+            if (B.row_less(oth, cur))
                 std::swap(oth, cur);
             else
                 Z.update_low(cur);
@@ -204,8 +290,11 @@ remove_impl(Index cell)
     {
         //std::cout << "  death" << std::endl;
 
-        auto index_chain_cmp = [this](const typename IndexChain::value_type& e1, const typename IndexChain::value_type& e2)
-                               { return this->cmp()(e1.index(), e2.index()); };
+        // the chains of cycles are ordered by their ids, the chains of boundaries in any consistent way
+        typedef     typename IndexChain::value_type         IndexEntry;
+        auto        z_cmp           = [this](Index z1, Index z2)                        { return this->B.row_less(z1, z2); };
+        auto        index_chain_cmp = [this](const IndexEntry& e1, const IndexEntry& e2) { return this->B.row_less(e1.index(), e2.index()); };
+        auto        b_chain_cmp     = [](const IndexEntry& e1, const IndexEntry& e2)     { return e1.index() < e2.index(); };
 
         // 1: change basis to clear z_row
         std::sort(z_row.begin(), z_row.end(), index_chain_cmp);     // this adds a log factor, but it makes life easier
@@ -224,8 +313,8 @@ remove_impl(Index cell)
 
                 assert(Z.col_exists(c));
                 assert(Z.col_exists(reducers.back()->index()));
-                if (cmp()(row(Z.col(c).back()),
-                          row(Z.col(reducers.back()->index()).back())))
+                if (Z.row_less(row(Z.col(c).back()),
+                               row(Z.col(reducers.back()->index()).back())))
                     reducers.push_back(it);
             }
             reducers.push_back(z_row.end());
@@ -233,8 +322,8 @@ remove_impl(Index cell)
             //std::cout << "z_row.size():    " << z_row.size() << std::endl;
 
 
-            std::map<Index, IndexChain>  b_changes;  // the rows to add to B
-            auto add_in_z = [this,&b_changes,&row_cmp,&index_chain_cmp](Index to, Index from, FieldElement m, FieldElement e)
+            std::map<Index, IndexChain, decltype(z_cmp)>    b_changes(z_cmp);   // the rows to add to B
+            auto add_in_z = [this,&b_changes,&row_cmp,&b_chain_cmp](Index to, Index from, FieldElement m, FieldElement e)
                             {
                                 //std::cout << "  add_in_z: " << from << ' ' << to << std::endl;
 
@@ -250,7 +339,7 @@ remove_impl(Index cell)
                                 IndexChain Bto_row;
                                 for (auto& x : this->B.row(to))
                                     Bto_row.emplace_back(x.element(), col(x));
-                                std::sort(Bto_row.begin(), Bto_row.end(), index_chain_cmp);
+                                std::sort(Bto_row.begin(), Bto_row.end(), b_chain_cmp);
 
 #if 0
                                 for (auto& x : this->B.row(to))
@@ -262,12 +351,12 @@ remove_impl(Index cell)
                                     std::cout << x.element() << ' ' << row(x) << ' ' << col(x) << std::endl;
 #endif
 
-                                Chain<IndexChain>::addto(b_changes[from], this->field().neg(mult), Bto_row, this->field(), index_chain_cmp);
+                                Chain<IndexChain>::addto(b_changes[from], this->field().neg(mult), Bto_row, this->field(), b_chain_cmp);
 
                                 // if there is b_changes[to] add it, too
                                 auto it = b_changes.find(to);
                                 if (it != b_changes.end())
-                                    Chain<IndexChain>::addto(b_changes[from], this->field().neg(mult), it->second, this->field(), index_chain_cmp);
+                                    Chain<IndexChain>::addto(b_changes[from], this->field().neg(mult), it->second, this->field(), b_chain_cmp);
                             };
             Index last_low = row(Z.col(reducers[reducers.size() - 2]->index()).back());
             for (int i = reducers.size() - 2; i >= 0; --i)
@@ -335,18 +424,99 @@ remove_impl(Index cell)
         assert(C.row(cell).empty());
         Z.drop_row(cell);
         C.drop_row(cell);
+        free_cell(cell);
         assert(B.row(j).empty());
         B.drop_row(j);
+        free_cycle(j);
 
-        Index birth = birth_index[j];
-        birth_index.erase(j);
-
-        return birth;
+        return birth_index[j];              // the slot is free, but its birth is still there
     }
 }
 
+template<class F, class I, class C>
+typename dionysus::ZigzagPersistence<F,I,C>::Index
+dionysus::ZigzagPersistence<F,I,C>::
+new_slot(Indices& free, Index& end)
+{
+    if (free.empty())
+        return end++;
+
+    Index s = free.back();
+    free.pop_back();
+    return s;
+}
 
-/* debug routines */
+template<class F, class I, class C>
+typename dionysus::ZigzagPersistence<F,I,C>::Index
+dionysus::ZigzagPersistence<F,I,C>::
+new_cell(Index id)
+{
+    Index c = new_slot(cell_free, cell_end);
+    Z.set_key(c, id);
+    C.set_key(c, id);
+    cell_slots[id] = c;
+    return c;
+}
+
+template<class F, class I, class C>
+typename dionysus::ZigzagPersistence<F,I,C>::Index
+dionysus::ZigzagPersistence<F,I,C>::
+new_cycle(Index id, Index op)
+{
+    Index z = new_slot(z_free, z_end);
+    B.set_key(z, id);
+    z_slots[id] = z;
+    if (z >= Index(birth_index.size()))
+        birth_index.resize(z + 1);
+    birth_index[z] = op;
+    return z;
+}
+
+template<class F, class I, class C>
+typename dionysus::ZigzagPersistence<F,I,C>::Index
+dionysus::ZigzagPersistence<F,I,C>::
+new_boundary()
+{
+    return new_slot(b_free, b_end);
+}
+
+template<class F, class I, class C>
+typename dionysus::ZigzagPersistence<F,I,C>::Indices
+dionysus::ZigzagPersistence<F,I,C>::
+alive_ops() const
+{
+    Indices res;
+    for (Index z = 0; z < z_end; ++z)
+        if (is_alive_slot(z))
+            res.push_back(birth_index[z]);
+    return res;
+}
+
+template<class F, class I, class C>
+typename dionysus::ZigzagPersistence<F,I,C>::Indices
+dionysus::ZigzagPersistence<F,I,C>::
+alive_cycles() const
+{
+    Indices res;
+    for (Index z = 0; z < z_end; ++z)
+        if (is_alive_slot(z))
+            res.push_back(B.key(z));
+    return res;
+}
+
+template<class F, class I, class C>
+typename dionysus::ZigzagPersistence<F,I,C>::Column
+dionysus::ZigzagPersistence<F,I,C>::
+cycle(Index i) const
+{
+    Column res;
+    for (auto& x : Z.col(z_slots.find(i)->second))
+        res.emplace_back(x.element(), Z.key(row(x)), i);
+    return res;
+}
+
+
+/* debug routines; they address the cells, the cycles, and the boundaries by their slots */
 template<class F, class I, class C>
 void
 dionysus::ZigzagPersistence<F,I,C>::
@@ -354,13 +524,17 @@ check_b_cols() const
 {
     // check that entries in B refer to existing Z columns
     bool stop = false;
-    for (auto& b : B.columns())
-        for (auto& x : b.second)
+    for (Index b = 0; b < b_end; ++b)
+    {
+        if (!B.col_exists(b))
+            continue;
+        for (auto& x : B.col(b))
             if (!Z.col_exists(row(x)))
             {
                 std::cout << "B refers to a non-existent column in Z: " << row(x) << std::endl;
                 stop = true;
             }
+    }
     if (stop)
         assert(0);
 }
@@ -373,12 +547,14 @@ check_cycles(const SimplexToIndex& s2i, const IndexToSimplex& i2s) const
 {
     typedef     typename Column::value_type             Entry;
     auto        row_cmp = [this](const Entry& e1, const Entry& e2)
-                          { return this->cmp()(row(e1), row(e2)); };
+                          { return this->Z.row_less(row(e1), row(e2)); };
 
-    for (auto& z : Z.columns())
+    for (Index z = 0; z < z_end; ++z)
     {
+        if (!Z.col_exists(z))
+            continue;
         Column res;
-        for (auto& x : z.second)
+        for (auto& x : Z.col(z))
         {
             Column bdry = boundary(row(x), s2i, i2s);
             Chain<Column>::addto(res, x.element(), bdry, field(), row_cmp);
@@ -395,24 +571,19 @@ check_boundaries(const SimplexToIndex& s2i, const IndexToSimplex& i2s) const
 {
     check_cycles(s2i, i2s);
 
-    for (auto& x : B.columns())
-        if (!C.col_exists(x.first))
-        {
-            std::cout << x.first << " in B, but not in C" << std::endl;
-            assert(0);
-        }
-
-    for (auto& x : C.columns())
-        if (!B.col_exists(x.first))
+    for (Index b = 0; b < b_end; ++b)
+        if (B.col_exists(b) != C.col_exists(b))
         {
-            std::cout << x.first << " in B, but not in C" << std::endl;
+            std::cout << b << " in only one of B and C" << std::endl;
             assert(0);
         }
 
-    for (auto& x : B.columns())
+    for (Index b = 0; b < b_end; ++b)
     {
-        auto zb = zb_dot(x.first);
-        auto dc = dc_dot(x.first, s2i, i2s);
+        if (!B.col_exists(b))
+            continue;
+        auto zb = zb_dot(b);
+        auto dc = dc_dot(b, s2i, i2s);
 
         auto it_zb = zb.begin(),
              it_dc = dc.begin();
@@ -420,11 +591,11 @@ check_boundaries(const SimplexToIndex& s2i, const IndexToSimplex& i2s) const
         {
             if (it_zb->element() != it_dc->element() || row(*it_zb) != row(*it_dc))
             {
-                std::cout << "Boundary mismatch: " << x.first << std::endl;
+                std::cout << "Boundary mismatch: " << b << std::endl;
                 std::cout << "===" << std::endl;
                 for (auto& x : zb)
                     std::cout << "   " << x.element() << ' ' << row(x) << std::endl;
-                for (auto& y : B.col(x.first))
+                for (auto& y : B.col(b))
                 {
                     std::cout << "   " << y.element() << " * " << row(y) << std::endl;
                     for (auto& z : Z.col(row(y)))
@@ -434,7 +605,7 @@ check_boundaries(const SimplexToIndex& s2i, const IndexToSimplex& i2s) const
                 std::cout << "===" << std::endl;
                 for (auto& x : dc)
                     std::cout << "   " << x.element() << ' ' << row(x) << std::endl;
-                for (auto& y : C.col(x.first))
+                for (auto& y : C.col(b))
                 {
                     std::cout << "   " << y.element() << " * " << row(y) << std::endl;
                     for (auto& z : boundary(row(y), s2i, i2s))
@@ -459,7 +630,7 @@ zb_dot(Index c) const
 {
     typedef     typename Column::value_type             Entry;
     auto        row_cmp = [this](const Entry& e1, const Entry& e2)
-                          { return this->cmp()(row(e1), row(e2)); };
+                          { return this->Z.row_less(row(e1), row(e2)); };
     Column res;
     for (auto& x : B.col(c))
         Chain<Column>::addto(res, x.element(), Z.col(row(x)), field(), row_cmp);
@@ -475,7 +646,7 @@ dc_dot(Index c, const SimplexToIndex& s2i, const IndexToSimplex& i2s) const
 {
     typedef     typename Column::value_type             Entry;
     auto        row_cmp = [this](const Entry& e1, const Entry& e2)
-                          { return this->cmp()(row(e1), row(e2)); };
+                          { return this->Z.row_less(row(e1), row(e2)); };
     Column res;
     for (auto& x : C.col(c))
     {
@@ -493,11 +664,11 @@ boundary(Index i, const SimplexToIndex& s2i, const IndexToSimplex& i2s) const
 {
     typedef     typename Column::value_type             Entry;
     auto        row_cmp = [this](const Entry& e1, const Entry& e2)
-                          { return this->cmp()(row(e1), row(e2)); };
+                          { return this->Z.row_less(row(e1), row(e2)); };
     Column bdry;
-    auto s = i2s(i);
+    auto s = i2s(Z.key(i));
     for (auto y : s.boundary(field()))
-        bdry.emplace_back(y.element(), s2i(y.index()), 0);
+        bdry.emplace_back(y.element(), cell_slots.find(s2i(y.index()))->second, 0);
     std::sort(bdry.begin(), bdry.end(), row_cmp);
     return bdry;
 }
@@ -509,27 +680,27 @@ check_sorted() const
 {
     typedef     typename Column::value_type             Entry;
     auto        row_cmp = [this](const Entry& e1, const Entry& e2)
-                          { return this->cmp()(row(e1), row(e2)); };
+                          { return this->Z.row_less(row(e1), row(e2)); };
     typedef     typename DequeColumn::value_type        DequeEntry;
     auto        b_row_cmp = [this](const DequeEntry& e1, const DequeEntry& e2)
-                            { return this->cmp()(row(e1), row(e2)); };
+                            { return this->B.row_less(row(e1), row(e2)); };
 
-    for (auto& x : Z.columns())
-        if (!std::is_sorted(x.second.begin(), x.second.end(), row_cmp))
+    for (Index z = 0; z < z_end; ++z)
+        if (Z.col_exists(z) && !std::is_sorted(Z.col(z).begin(), Z.col(z).end(), row_cmp))
         {
-            std::cout << "Z column not sorted: " << x.first << std::endl;
+            std::cout << "Z column not sorted: " << z << std::endl;
             assert(0);
         }
-    for (auto& x : C.columns())
-        if (!std::is_sorted(x.second.begin(), x.second.end(), row_cmp))
+    for (Index b = 0; b < b_end; ++b)
+        if (C.col_exists(b) && !std::is_sorted(C.col(b).begin(), C.col(b).end(), row_cmp))
         {
-            std::cout << "C column not sorted: " << x.first << std::endl;
+            std::cout << "C column not sorted: " << b << std::endl;
             assert(0);
         }
-    for (auto& x : B.columns())
-        if (!std::is_sorted(x.second.begin(), x.second.end(), b_row_cmp))
+    for (Index b = 0; b < b_end; ++b)
+        if (B.col_exists(b) && !std::is_sorted(B.col(b).begin(), B.col(b).end(), b_row_cmp))
         {
-            std::cout << "B column not sorted: " << x.first << std::endl;
+            std::cout << "B column not sorted: " << b << std::endl;
             assert(0);
         }
 }
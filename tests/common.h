@@ -0,0 +1,111 @@
+#ifndef DIONYSUS_TESTS_COMMON_H
+#define DIONYSUS_TESTS_COMMON_H
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include <dionysus/simplex.h>
+#include <dionysus/filtration.h>
+
+namespace d = dionysus;
+
+typedef     d::Simplex<unsigned, float>     Simplex;
+typedef     d::Filtration<Simplex>          Filtration;
+
+static int  failures = 0;
+
+#define CHECK(cond)                                                                         \
+    do { if (!(cond)) { std::cerr << __FILE__ << ':' << __LINE__ << ": check failed: "      \
+                                  << #cond << std::endl; ++failures; } } while (0)
+
+typedef     std::vector<std::vector<float>>     Distances;
+
+// symmetric matrix of random distances in [0,1)
+inline Distances
+random_distances(unsigned n, unsigned seed)
+{
+    std::mt19937                            gen(seed);
+    std::uniform_real_distribution<float>   length(0, 1);
+
+    Distances distances(n, std::vector<float>(n, 0));
+    for (unsigned u = 0; u < n; ++u)
+        for (unsigned v = u + 1; v < n; ++v)
+            distances[u][v] = distances[v][u] = length(gen);
+    return distances;
+}
+
+// Flag complex, up to dimension max_dim; each simplex appears at the length of its longest edge.
+inline Filtration
+flag_filtration(const Distances& distances, unsigned max_dim)
+{
+    unsigned n = distances.size();
+
+    std::vector<Simplex>    simplices;
+    std::vector<unsigned>   vertices;
+    auto expand = [&](unsigned first, float value, const auto& expand) -> void
+    {
+        if (!vertices.empty())
+            simplices.emplace_back(vertices, value);
+        if (vertices.size() == max_dim + 1)
+            return;
+        for (unsigned v = first; v < n; ++v)
+        {
+            float w = value;
+            for (unsigned u : vertices)
+                w = std::max(w, distances[u][v]);
+            vertices.push_back(v);
+            expand(v + 1, w, expand);
+            vertices.pop_back();
+        }
+    };
+    expand(0, 0, expand);
+
+    std::sort(simplices.begin(), simplices.end(), [](const Simplex& s1, const Simplex& s2)
+              { return s1.data() < s2.data() || (s1.data() == s2.data() && s1.dimension() < s2.dimension()); });
+    return Filtration(simplices.begin(), simplices.end());
+}
+
+// Flag complex of n vertices with random edge lengths
+inline Filtration
+random_flag_filtration(unsigned n, unsigned max_dim, unsigned seed)
+{
+    return flag_filtration(random_distances(n, seed), max_dim);
+}
+
+// The 6-vertex triangulation of the real projective plane: its homology differs over Z2 and Z3
+inline Filtration
+projective_plane()
+{
+    std::vector<Simplex> simplices;
+    for (unsigned v = 0; v < 6; ++v)
+        simplices.push_back(Simplex({v}, 0));
+    for (unsigned u = 0; u < 6; ++u)
+        for (unsigned v = u + 1; v < 6; ++v)
+            simplices.push_back(Simplex({u,v}, 1));
+    for (auto t : std::vector<std::vector<unsigned>> { {0,1,2}, {0,2,3}, {0,3,4}, {0,4,5}, {0,5,1},
+                                                       {1,2,4}, {2,3,5}, {3,4,1}, {4,5,2}, {5,1,3} })
+        simplices.push_back(Simplex(t, 2));
+    return Filtration(simplices.begin(), simplices.end());
+}
+
+// pair(i) for every cell, through any type that has one
+template<class Persistence>
+std::vector<typename Persistence::Index>
+pairs(const Persistence& persistence)
+{
+    std::vector<typename Persistence::Index> result;
+    for (size_t i = 0; i < persistence.size(); ++i)
+        result.push_back(persistence.pair(i));
+    return result;
+}
+
+inline int  report(const char* name)
+{
+    if (failures)
+        std::cerr << name << ": " << failures << " checks failed" << std::endl;
+    return failures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,67 @@
+#include <dionysus/fields/z2.h>
+#include <dionysus/fields/zp.h>
+#include <dionysus/ordinary-persistence.h>
+#include <dionysus/standard-reduction.h>
+#include <dionysus/chunk-reduction.h>
+
+#include "common.h"
+
+// pairs match those of StandardReduction, for any number of threads (and so of chunks),
+// and every negative column is a reduced column with the pair as its pivot
+template<class Field>
+void check(const Field& field, const Filtration& filtration)
+{
+    typedef     d::OrdinaryPersistence<Field>       Persistence;
+
+    Persistence                         expected(field);
+    d::StandardReduction<Persistence>   reduce(expected);
+    reduce(filtration);
+
+    size_t paired = 0;
+    for (size_t i = 0; i < expected.size(); ++i)
+        if (expected.pair(i) != expected.unpaired())
+            ++paired;
+
+    // with 64 threads there are more chunks than columns in any dimension (of the small filtrations)
+    for (unsigned threads : { 1, 2, 3, 8, 64 })
+    {
+        Persistence                         persistence(field);
+        d::ChunkReduction<Persistence>      chunk_reduce(persistence, threads);
+
+        size_t reported = 0;
+        chunk_reduce(filtration, [&reported](int, unsigned, unsigned) { ++reported; });
+
+        CHECK(pairs(persistence) == pairs(expected));
+        CHECK(2*reported == paired);
+
+        for (size_t j = 0; j < persistence.size(); ++j)
+        {
+            auto i = persistence.pair(j);
+            if (i != persistence.unpaired() && i < j)
+                CHECK(!persistence[j].empty() && persistence[j].back().index() == i);
+        }
+    }
+}
+
+int main()
+{
+    for (unsigned seed = 0; seed < 3; ++seed)
+    {
+        Filtration filtration = random_flag_filtration(20, 3, seed);
+        check(d::Z2Field(), filtration);
+        check(d::ZpField<short>(3), filtration);
+        check(d::ZpField<short>(11), filtration);
+    }
+
+    for (unsigned seed = 0; seed < 3; ++seed)
+    {
+        Filtration filtration = random_flag_filtration(6, 2, seed);
+        check(d::Z2Field(), filtration);
+        check(d::ZpField<short>(3), filtration);
+    }
+
+    check(d::Z2Field(), projective_plane());
+    check(d::ZpField<short>(3), projective_plane());
+
+    return report("chunk-reduction");
+}
@@ -0,0 +1,132 @@
+#include <map>
+
+#include <dionysus/fields/zp.h>
+#include <dionysus/trails-chains.h>
+#include <dionysus/standard-reduction.h>
+#include <dionysus/clearing-reduction.h>
+
+#include "common.h"
+
+typedef     d::ZpField<short>                           Zp;
+typedef     d::OrdinaryPersistenceWithV<Zp>             Persistence;
+typedef     Persistence::Index                          Index;
+
+// R = DV, and V is upper-triangular with a non-zero diagonal
+void check_decomposition(const Persistence& persistence, const Filtration& filtration)
+{
+    auto& field = persistence.field();
+    auto& v     = const_cast<Persistence&>(persistence).visitor<0>().v_;
+
+    for (Index i = 0; i < filtration.size(); ++i)
+    {
+        std::map<Index, Zp::Element> dv;
+        for (auto& x : v[i])
+            for (auto&& y : filtration[x.index()].boundary(field))
+            {
+                auto& e = dv[filtration.index(y.index(), x.index())];
+                e = field.add(e, field.mul(x.element(), y.element()));
+            }
+
+        std::map<Index, Zp::Element> r;
+        for (auto& x : persistence[i])
+            r[x.index()] = x.element();
+
+        for (auto& x : dv)
+            CHECK(field.is_zero(x.second) ? r.count(x.first) == 0 : r[x.first] == x.second);
+        for (auto& x : r)
+            CHECK(!field.is_zero(dv[x.first]));
+
+        CHECK(!v[i].empty() && v[i].back().index() == i);
+    }
+}
+
+// the pairs match a reduction without clearing, and R = DV still holds
+void check(const Persistence& persistence, const Filtration& filtration)
+{
+    Persistence expected(Zp(3));
+    d::StandardReduction<Persistence> reduce(expected);
+    reduce(filtration);
+
+    CHECK(pairs(persistence) == pairs(expected));
+    check_decomposition(persistence, filtration);
+}
+
+// counts the columns that are set, i.e., stored
+template<class Self>
+struct SetCounter: public d::EmptyVisitor<Zp, Index, Self>
+{
+    template<class Chain>
+    void        chain_initialized(Self*, Index, Chain&)         { ++count; }
+
+    size_t      count = 0;
+};
+
+typedef     d::OrdinaryPersistence<Zp, Index, std::less<Index>, SetCounter>     CountingPersistence;
+
+// with apparent pairs, the pairs match the standard reduction; the apparent columns
+// aren't reduced, and no more columns are stored than without them
+void check_apparent(const Filtration& filtration, int max_dim)
+{
+    CountingPersistence                         expected(Zp(3));
+    d::StandardReduction<CountingPersistence>   reduce(expected);
+    reduce.set_max_dimension(max_dim);
+    reduce(filtration);
+
+    CountingPersistence                         cleared(Zp(3));
+    d::ClearingReduction<CountingPersistence>   clear(cleared);
+    clear.set_max_dimension(max_dim);
+    clear(filtration);
+
+    CountingPersistence                         apparent(Zp(3));
+    d::ClearingReduction<CountingPersistence>   clear_apparent(apparent);
+    clear_apparent.set_max_dimension(max_dim);
+    clear_apparent.set_apparent_pairs();
+    clear_apparent(filtration);
+
+    CHECK(pairs(apparent) == pairs(expected));
+    CHECK(pairs(cleared)  == pairs(expected));
+
+    size_t n_apparent = 0;
+    auto   found = d::apparent_pairs(filtration);
+    for (Index t = 0; t < filtration.size(); ++t)
+        if (found[t] != CountingPersistence::unpaired() && found[t] < t &&
+            (max_dim < 0 || filtration[t].dimension() <= unsigned(max_dim) + 1))
+        {
+            CHECK(apparent.pair(t) == found[t]);
+            ++n_apparent;
+        }
+    CHECK(n_apparent > 0);
+
+    auto& stats = clear_apparent.statistics();
+    CHECK(stats.reduced + n_apparent == clear.statistics().reduced);
+    CHECK(stats.cleared == clear.statistics().cleared);
+    CHECK(apparent.visitor<0>().count == cleared.visitor<0>().count);
+    CHECK(apparent.visitor<0>().count + stats.cleared + stats.skipped == filtration.size());
+}
+
+int main()
+{
+    for (unsigned seed = 0; seed < 3; ++seed)
+    {
+        Filtration filtration = random_flag_filtration(10, 3, seed);
+
+        Persistence                         twisted(Zp(3));
+        d::StandardReduction<Persistence>   twist(twisted);
+        twist.set_clearing();
+        twist(filtration);
+        check(twisted, filtration);
+        CHECK(twist.statistics().cleared > 0);
+
+        Persistence                         cleared(Zp(3));
+        d::ClearingReduction<Persistence>   clear(cleared);
+        clear(filtration);
+        check(cleared, filtration);
+        CHECK(clear.statistics().cleared > 0);
+
+        for (int max_dim : { -1, 1 })
+            check_apparent(filtration, max_dim);
+    }
+    check_apparent(projective_plane(), -1);
+
+    return report("clearing");
+}
@@ -0,0 +1,135 @@
+#include <tuple>
+#include <limits>
+
+#include <dionysus/fields/zp.h>
+#include <dionysus/rips.h>
+#include <dionysus/combinatorial-simplex.h>
+#include <dionysus/cohomology-persistence.h>
+#include <dionysus/standard-reduction.h>
+#include <dionysus/pair-recorder.h>
+
+#include "common.h"
+
+typedef     d::ZpField<short>                                   Zp;
+typedef     d::CombinatorialSimplex<unsigned>                   CSimplex;
+typedef     std::vector<unsigned>                               Vertices;
+typedef     std::vector<std::tuple<short, Vertices>>            Faces;          // (coefficient, ascending vertices)
+typedef     std::vector<std::tuple<unsigned, float, float>>     Diagram;        // (dimension, birth, death)
+
+struct MatrixDistances
+{
+    typedef     unsigned    IndexType;
+    typedef     float       DistanceType;
+
+    DistanceType    operator()(IndexType u, IndexType v) const  { return distances[u][v]; }
+    IndexType       begin() const                               { return 0; }
+    IndexType       end() const                                 { return distances.size(); }
+    IndexType       size() const                                { return distances.size(); }
+
+    const Distances&    distances;
+};
+
+const float infinity = std::numeric_limits<float>::infinity();
+
+template<class Range>
+Faces       faces(const Range& chain)
+{
+    Faces result;
+    for (auto&& e : chain)
+    {
+        const auto& s = e.index();
+        Vertices vertices(s.begin(), s.end());
+        std::sort(vertices.begin(), vertices.end());
+        result.emplace_back(e.element(), vertices);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// cofaces of s in the full simplex on n vertices, with the coefficient of s in their boundary
+Faces       full_coboundary(const Vertices& s, unsigned n, const Zp& field)
+{
+    Faces result;
+    for (unsigned v = 0; v < n; ++v)
+    {
+        if (std::find(s.begin(), s.end(), v) != s.end())
+            continue;
+        Vertices coface = s;
+        auto pos = std::lower_bound(coface.begin(), coface.end(), v);
+        bool even = (pos - coface.begin()) % 2 == 0;
+        coface.insert(pos, v);
+        result.emplace_back(even ? field.id() : field.neg(field.id()), coface);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+template<class Simplex_>
+Diagram     rips_diagram(const Distances& distances, unsigned k, short p)
+{
+    typedef     d::Rips<MatrixDistances, Simplex_>                      Generator;
+    typedef     d::Filtration<Simplex_>                                 RipsFiltration;
+    typedef     d::PairRecorder<d::CohomologyPersistence<Zp>>           Persistence;
+
+    MatrixDistances     matrix { distances };
+    Generator           rips(matrix);
+    RipsFiltration      filtration;
+    rips.generate(k, infinity, [&filtration](Simplex_&& s) { filtration.push_back(s); });
+    filtration.sort(typename Generator::Comparison(matrix));
+
+    Persistence                         persistence(Zp{p});
+    d::StandardReduction<Persistence>   reduce(persistence);
+    reduce(filtration);
+
+    typename Generator::Evaluator eval(matrix);
+    Diagram diagram;
+    for (size_t i = 0; i < filtration.size(); ++i)
+    {
+        auto j = persistence.pair(i);
+        float birth = eval(filtration[i]);
+        if (j == persistence.unpaired())
+            diagram.emplace_back(filtration[i].dimension(), birth, infinity);
+        else if (i < j && birth != eval(filtration[j]))
+            diagram.emplace_back(filtration[i].dimension(), birth, eval(filtration[j]));
+    }
+    std::sort(diagram.begin(), diagram.end());
+    return diagram;
+}
+
+int main()
+{
+    // vertices are enumerated in decreasing order
+    CSimplex t { 3, 1, 7 };
+    CHECK(t.dimension() == 2);
+    CHECK(Vertices(t.begin(), t.end()) == Vertices({ 7, 3, 1 }));
+    CHECK(t == CSimplex({ 7, 1, 3 }));
+    CHECK(t != CSimplex({ 7, 1, 2 }));
+
+    // boundaries and coboundaries agree with Simplex's
+    const unsigned n = 9;
+    const unsigned k = 3;
+    CSimplex::reserve(n, k + 1);
+    Filtration filtration = random_flag_filtration(n, k, 0);
+    for (short p : { 2, 3, 5 })
+    {
+        Zp field(p);
+        for (auto& s : filtration)
+        {
+            Vertices vertices(s.begin(), s.end());
+            CSimplex c(vertices);
+            CHECK(Vertices(c.begin(), c.end()) == Vertices(vertices.rbegin(), vertices.rend()));
+            CHECK(faces(c.boundary(field)) == faces(s.boundary(field)));
+            CHECK(faces(c.coboundary(field, n)) == full_coboundary(vertices, n, field));
+        }
+    }
+
+    // so do the diagrams of Rips complexes
+    for (unsigned seed = 0; seed < 5; ++seed)
+    {
+        Distances distances = random_distances(12, seed);
+        for (short p : { 2, 3 })
+            CHECK(rips_diagram<CSimplex>(distances, 2, p) == rips_diagram<d::Simplex<unsigned>>(distances, 2, p));
+    }
+
+    return report("combinatorial-simplex");
+}
@@ -0,0 +1,71 @@
+#include <dionysus/fields/z2.h>
+#include <dionysus/fields/zp.h>
+#include <dionysus/cohomology-persistence.h>
+#include <dionysus/compact-cohomology-persistence.h>
+#include <dionysus/standard-reduction.h>
+#include <dionysus/pair-recorder.h>
+
+#include "common.h"
+
+// the pairs and the cocycles match those of CohomologyPersistence, on inputs large
+// enough that the slots of the dead cocycles are reused and the rows get compacted
+template<class Field>
+void check(const Field& field, const Filtration& filtration, int max_dim = -1)
+{
+    typedef     d::PairChainRecorder<d::CohomologyPersistence<Field>>           Expected;
+    typedef     d::PairChainRecorder<d::CompactCohomologyPersistence<Field>>    Compact;
+    typedef     typename Compact::Index                                         Index;
+
+    Expected                            expected(field);
+    d::StandardReduction<Expected>      reduce_expected(expected);
+    reduce_expected.set_max_dimension(max_dim);
+    reduce_expected(filtration);
+
+    Compact                             compact(field);
+    d::StandardReduction<Compact>       reduce_compact(compact);
+    reduce_compact.set_max_dimension(max_dim);
+    size_t reported = 0;
+    reduce_compact(filtration, [&reported](int, Index, Index) { ++reported; });
+
+    CHECK(compact.size() == filtration.size());
+    CHECK(pairs(compact) == pairs(expected));
+
+    size_t births = 0, deaths = 0;
+    for (Index i = 0; i < filtration.size(); ++i)
+    {
+        CHECK(compact.skip(i) == expected.skip(i));
+
+        Index j = compact.pair(i);
+        if (j != compact.unpaired() && j < i)
+        {
+            ++deaths;
+
+            auto c1 = compact.chain(i), c2 = expected.chain(i);
+            CHECK(c1.size() == c2.size());
+            for (size_t k = 0; k < std::min(c1.size(), c2.size()); ++k)
+                CHECK(c1[k].index() == c2[k].index() && field.is_zero(field.add(c1[k].element(), field.neg(c2[k].element()))));
+        } else if (!compact.skip(i))
+            ++births;
+    }
+    CHECK(reported == deaths);
+
+    // the slots of the dead cocycles were reused, and the rows compacted
+    CHECK(compact.columns().size() < births);
+    CHECK(compact.alive() == births - deaths);
+    CHECK(compact.compactions() > 0);
+}
+
+int main()
+{
+    for (unsigned seed = 0; seed < 3; ++seed)
+    {
+        // several thousand cells
+        Filtration filtration = random_flag_filtration(20, 3, seed);
+        check(d::Z2Field(), filtration);
+        check(d::ZpField<short>(3), filtration);
+        check(d::ZpField<short>(11), filtration);
+        check(d::ZpField<short>(3), filtration, 1);
+    }
+
+    return report("compact-cohomology");
+}
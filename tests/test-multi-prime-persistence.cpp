@@ -0,0 +1,103 @@
+#include <boost/range/adaptors.hpp>
+namespace ba = boost::adaptors;
+
+#include <dionysus/fields/zp.h>
+#include <dionysus/ordinary-persistence.h>
+#include <dionysus/multi-prime-persistence.h>
+
+#include "common.h"
+
+typedef     d::MultiPrimePersistence<2>                 MultiPrime;
+typedef     d::ZpField<short>                           Zp;
+typedef     d::OrdinaryPersistence<Zp>                  Persistence;
+
+// add the cells in order, skipping those above max_dim
+template<class P>
+void reduce(P& persistence, const Filtration& filtration, unsigned max_dim)
+{
+    typedef     d::ChainEntry<typename P::Field, Simplex>                   SimplexChainEntry;
+    typedef     d::ChainEntry<typename P::Field, typename P::Index>         ChainEntry;
+
+    size_t i = 0;
+    for (auto& s : filtration)
+    {
+        if (s.dimension() > max_dim)
+            persistence.add_skip();
+        else
+            persistence.add(s.boundary(persistence.field()) |
+                            ba::transformed([&filtration,i](const SimplexChainEntry& e)
+                            { return ChainEntry(e.element(), filtration.index(e.index(),i)); }));
+        ++i;
+    }
+}
+
+// pairs over each prime match a separate reduction over that prime
+// returns the number of split columns
+size_t check(const Filtration& filtration, unsigned max_dim = 3)
+{
+    MultiPrime::Primes primes {{ 2, 3 }};
+
+    MultiPrime multi(primes);
+    reduce(multi, filtration, max_dim);
+    CHECK(multi.size() == filtration.size());
+
+    for (size_t i = 0; i < filtration.size(); ++i)
+        CHECK(multi.skip(i) == (filtration[i].dimension() > max_dim));
+
+    for (auto p : primes)
+    {
+        Persistence persistence(Zp{p});
+        reduce(persistence, filtration, max_dim);
+
+        for (size_t i = 0; i < filtration.size(); ++i)
+            CHECK(multi.pair(i, p) == persistence.pair(i));
+    }
+
+    return multi.splits();
+}
+
+// lane-wise arithmetic matches ZpField in each lane
+template<class Element>
+void check_lanes(const std::array<Element, 4>& primes)
+{
+    typedef     d::MultiZpField<4, Element>     Field;
+
+    Field           field(primes);
+    std::mt19937    gen(0);
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+        typename Field::Element x, a, y;
+        for (unsigned k = 0; k < 4; ++k)
+        {
+            std::uniform_int_distribution<int> element(0, primes[k] - 1);
+            x[k] = element(gen); a[k] = element(gen); y[k] = element(gen);
+        }
+
+        auto sum = field.add(x, y), product = field.mul(a, y), muladd = field.muladd(x, a, y);
+        for (unsigned k = 0; k < 4; ++k)
+        {
+            auto& lane = field.lane(k);
+            CHECK(sum[k]     == lane.add(x[k], y[k]));
+            CHECK(product[k] == lane.mul(a[k], y[k]));
+            CHECK(muladd[k]  == lane.muladd(x[k], a[k], y[k]));
+        }
+    }
+}
+
+int main()
+{
+    check_lanes<short>({{ 2, 3, 11, 32749 }});
+    check_lanes<int>({{ 2, 5, 251, 65521 }});
+
+    // the pairs differ between Z2 and Z3, so the columns split
+    CHECK(check(projective_plane()) > 0);
+
+    for (unsigned seed = 0; seed < 5; ++seed)
+        check(random_flag_filtration(10, 3, seed));
+
+    // skipped cells must keep the indices aligned with the filtration
+    check(random_flag_filtration(10, 3, 17), 2);
+    check(random_flag_filtration(10, 3, 17), 1);
+
+    return report("multi-prime-persistence");
+}
@@ -0,0 +1,52 @@
+#include <dionysus/fields/z2.h>
+#include <dionysus/fields/zp.h>
+#include <dionysus/ordinary-persistence.h>
+#include <dionysus/standard-reduction.h>
+#include <dionysus/parallel-reduction.h>
+
+#include "common.h"
+
+// pairs match those of StandardReduction, for any number of threads
+template<class Field>
+void check(const Field& field, const Filtration& filtration)
+{
+    typedef     d::OrdinaryPersistence<Field>       Persistence;
+
+    Persistence                         expected(field);
+    d::StandardReduction<Persistence>   reduce(expected);
+    reduce(filtration);
+
+    for (unsigned threads : { 1, 2, 4, 8 })
+    {
+        Persistence                         persistence(field);
+        d::ParallelReduction<Persistence>   parallel_reduce(persistence, threads);
+
+        size_t reported = 0;
+        parallel_reduce(filtration, [&reported](int, unsigned, unsigned) { ++reported; });
+
+        CHECK(pairs(persistence) == pairs(expected));
+
+        size_t paired = 0;
+        for (size_t i = 0; i < expected.size(); ++i)
+            if (expected.pair(i) != expected.unpaired())
+                ++paired;
+        CHECK(2*reported == paired);
+    }
+}
+
+int main()
+{
+    for (unsigned seed = 0; seed < 3; ++seed)
+    {
+        // several thousand cells, so that the threads take many chunks
+        Filtration filtration = random_flag_filtration(20, 3, seed);
+        check(d::Z2Field(), filtration);
+        check(d::ZpField<short>(3), filtration);
+        check(d::ZpField<short>(11), filtration);
+    }
+
+    check(d::Z2Field(), projective_plane());
+    check(d::ZpField<short>(3), projective_plane());
+
+    return report("parallel-reduction");
+}
@@ -0,0 +1,81 @@
+#include <dionysus/fields/zp.h>
+#include <dionysus/ordinary-persistence.h>
+#include <dionysus/standard-reduction.h>
+
+#include "common.h"
+
+typedef     d::ZpField<short>                           Zp;
+typedef     d::OrdinaryPersistence<Zp>                  Persistence;
+typedef     Persistence::Index                          Index;
+
+// boundaries of the cells, none reduced yet
+Persistence boundary_matrix(const Filtration& filtration, const Zp& field)
+{
+    Persistence m(field);
+    m.resize(filtration.size());
+    for (Index i = 0; i < filtration.size(); ++i)
+    {
+        Persistence::Chain chain;
+        for (auto&& x : filtration[i].boundary(field))
+            chain.emplace_back(x.element(), filtration.index(x.index(), i));
+        m.set(i, std::move(chain));
+    }
+    return m;
+}
+
+// reducing up to a value reduces exactly the cells with values up to and including it,
+// in increasing steps, and the pairs within the prefix are those of the full reduction
+void check(const Filtration& filtration, const Zp& field)
+{
+    auto value = [](const Simplex& s, Index) { return s.data(); };
+
+    Persistence                         expected(field);
+    d::StandardReduction<Persistence>   reduce(expected);
+    reduce(filtration);
+
+    Persistence m = boundary_matrix(filtration, field);
+    CHECK(m.reduced() == 0);
+
+    // the values of the cells, and a few in between, including ties (e.g., a triangle and its longest edge)
+    std::vector<float> xs { -1 };
+    for (auto& s : filtration)
+        xs.push_back(s.data());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+    for (size_t k = 0; k < xs.size(); k += 7)
+    {
+        float x = xs[k];
+        Index n = std::count_if(filtration.begin(), filtration.end(), [x](const Simplex& s) { return s.data() <= x; });
+        CHECK(d::reduce_upto(m, filtration, x, value) == n);
+        CHECK(m.reduced() == n);
+        CHECK(n == 0 || filtration[n-1].data() <= x);
+        CHECK(n == filtration.size() || filtration[n].data() > x);
+
+        for (Index i = 0; i < n; ++i)
+        {
+            Index p = expected.pair(i);
+            CHECK(m.pair(i) == (p < n ? p : m.unpaired()));
+        }
+    }
+
+    // a smaller value does nothing; a stop() that fires right away reduces nothing
+    Index reduced = m.reduced();
+    CHECK(d::reduce_upto(m, filtration, -1.f, value) == reduced);
+    CHECK(d::reduce_upto(m, filtration, xs.back(), value, []() { return true; }) == reduced);
+
+    // the rest finishes the reduction
+    CHECK(d::reduce_upto(m, filtration, xs.back(), value) == filtration.size());
+    CHECK(pairs(m) == pairs(expected));
+}
+
+int main()
+{
+    for (unsigned seed = 0; seed < 3; ++seed)
+    {
+        Filtration filtration = random_flag_filtration(12, 3, seed);
+        for (short p : { 2, 3 })
+            check(filtration, Zp(p));
+    }
+    check(projective_plane(), Zp(2));
+
+    return report("reduce-upto");
+}
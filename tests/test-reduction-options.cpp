@@ -0,0 +1,112 @@
+#include <tuple>
+#include <limits>
+
+#include <dionysus/fields/zp.h>
+#include <dionysus/ordinary-persistence.h>
+#include <dionysus/cohomology-persistence.h>
+#include <dionysus/pair-recorder.h>
+#include <dionysus/standard-reduction.h>
+#include <dionysus/clearing-reduction.h>
+#include <dionysus/pipeline-reduction.h>
+
+#include "common.h"
+
+typedef     d::ZpField<short>                                   Zp;
+typedef     std::vector<std::tuple<unsigned, float, float>>     Points;         // (dimension, birth, death)
+
+const float infinity = std::numeric_limits<float>::infinity();
+
+// the points of the cells that aren't skipped, including those on the diagonal
+template<class Persistence>
+Points      points(const Persistence& persistence, const Filtration& filtration)
+{
+    Points result;
+    for (size_t i = 0; i < filtration.size(); ++i)
+    {
+        if (persistence.skip(i))
+            continue;
+        auto j = persistence.pair(i);
+        if (j == persistence.unpaired())
+            result.emplace_back(filtration[i].dimension(), filtration[i].data(), infinity);
+        else if (i < j)
+            result.emplace_back(filtration[i].dimension(), filtration[i].data(), filtration[j].data());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+template<class Reduction>
+void        set_clearing(Reduction&, bool)                                  {}
+
+template<class P>
+void        set_clearing(d::StandardReduction<P>& reduce, bool flag)        { reduce.set_clearing(flag); }
+
+// with a maximum dimension and a report threshold, the points are those of the full
+// reduction up to max_dim, without the pairs shorter than epsilon (which are counted as filtered)
+template<class Reduction>
+void check(const Filtration& filtration, const Points& full, int max_dim, float epsilon, bool clearing = false)
+{
+    typename Reduction::Persistence     persistence(Zp(3));
+    Reduction                           reduce(persistence);
+    set_clearing(reduce, clearing);
+    reduce.set_max_dimension(max_dim);
+    if (epsilon > 0)
+        reduce.set_report_threshold(epsilon, [&filtration](unsigned i) { return filtration[i].data(); });
+
+    size_t reported = 0;
+    reduce(filtration, [&reported](int, unsigned, unsigned) { ++reported; });
+
+    Points  expected;
+    size_t  filtered = 0;
+    for (auto& p : full)
+    {
+        if (max_dim >= 0 && std::get<0>(p) > unsigned(max_dim))
+            continue;
+        if (std::get<2>(p) - std::get<1>(p) < epsilon)
+            ++filtered;
+        else
+            expected.push_back(p);
+    }
+    size_t finite = std::count_if(expected.begin(), expected.end(),
+                                  [](const std::tuple<unsigned, float, float>& p) { return std::get<2>(p) != infinity; });
+
+    CHECK(points(persistence, filtration) == expected);
+    CHECK(reported == finite);
+    CHECK(reduce.statistics().filtered == filtered);
+}
+
+void check_all(const Filtration& filtration)
+{
+    typedef     d::OrdinaryPersistence<Zp>                      Persistence;
+    typedef     d::PairRecorder<d::CohomologyPersistence<Zp>>   Cohomology;
+
+    Persistence                         persistence(Zp(3));
+    d::StandardReduction<Persistence>   reduce(persistence);
+    reduce(filtration);
+    Points full = points(persistence, filtration);
+    CHECK(reduce.statistics().filtered == 0);
+
+    // PipelineReduction records only the pairs, and says so
+    Persistence                         pipelined(Zp(3));
+    d::PipelineReduction<Persistence>   pipeline(pipelined);
+    pipeline(filtration);
+    CHECK(!persistence.pairs_only() && pipelined.pairs_only());
+
+    for (int max_dim : { -1, 0, 1 })
+        for (float epsilon : { 0.f, .05f, .2f })
+        {
+            check<d::StandardReduction<Persistence>>(filtration, full, max_dim, epsilon);
+            check<d::StandardReduction<Persistence>>(filtration, full, max_dim, epsilon, true);
+            check<d::ClearingReduction<Persistence>>(filtration, full, max_dim, epsilon);
+            check<d::PipelineReduction<Persistence>>(filtration, full, max_dim, epsilon);
+            check<d::StandardReduction<Cohomology>>(filtration, full, max_dim, epsilon);
+        }
+}
+
+int main()
+{
+    for (unsigned seed = 0; seed < 3; ++seed)
+        check_all(random_flag_filtration(10, 3, seed));
+
+    return report("reduction-options");
+}
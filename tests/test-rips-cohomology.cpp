@@ -0,0 +1,82 @@
+#include <tuple>
+#include <limits>
+
+#include <dionysus/fields/zp.h>
+#include <dionysus/cohomology-persistence.h>
+#include <dionysus/standard-reduction.h>
+#include <dionysus/pair-recorder.h>
+#include <dionysus/rips-cohomology.h>
+
+#include "common.h"
+
+typedef     d::ZpField<short>                                   Zp;
+typedef     std::vector<std::tuple<unsigned, float, float>>     Diagram;        // (dimension, birth, death)
+
+struct MatrixDistances
+{
+    typedef     unsigned    IndexType;
+    typedef     float       DistanceType;
+
+    DistanceType    operator()(IndexType u, IndexType v) const  { return distances[u][v]; }
+    IndexType       begin() const                               { return 0; }
+    IndexType       end() const                                 { return distances.size(); }
+
+    const Distances&    distances;
+};
+
+const float infinity = std::numeric_limits<float>::infinity();
+
+Diagram rips_cohomology(const Distances& distances, unsigned k, short p)
+{
+    MatrixDistances                             matrix { distances };
+    d::RipsCohomology<Zp, MatrixDistances>      persistence(Zp(p), matrix);
+
+    typedef     d::RipsCohomology<Zp, MatrixDistances>::Simplex     RipsSimplex;
+
+    Diagram diagram;
+    persistence(k, infinity,
+                [&diagram](unsigned d, const RipsSimplex& b, const RipsSimplex& s)
+                { if (b.data() != s.data()) diagram.emplace_back(d, b.data(), s.data()); },
+                [&diagram](unsigned d, const RipsSimplex& b)
+                { diagram.emplace_back(d, b.data(), infinity); });
+    std::sort(diagram.begin(), diagram.end());
+    return diagram;
+}
+
+Diagram cohomology_persistence(const Filtration& filtration, short p)
+{
+    typedef     d::PairRecorder<d::CohomologyPersistence<Zp>>   Persistence;
+
+    Persistence                         persistence(Zp{p});
+    d::StandardReduction<Persistence>   reduce(persistence);
+    reduce(filtration);
+
+    Diagram diagram;
+    for (size_t i = 0; i < filtration.size(); ++i)
+    {
+        auto j = persistence.pair(i);
+        float birth = filtration[i].data();
+        if (j == persistence.unpaired())
+            diagram.emplace_back(filtration[i].dimension(), birth, infinity);
+        else if (i < j && birth != filtration[j].data())
+            diagram.emplace_back(filtration[i].dimension(), birth, filtration[j].data());
+    }
+    std::sort(diagram.begin(), diagram.end());
+    return diagram;
+}
+
+int main()
+{
+    for (unsigned seed = 0; seed < 5; ++seed)
+    {
+        Distances distances = random_distances(12, seed);
+        for (unsigned k : { 1, 2 })
+        {
+            Filtration filtration = flag_filtration(distances, k);
+            for (short p : { 2, 3 })
+                CHECK(rips_cohomology(distances, k, p) == cohomology_persistence(filtration, p));
+        }
+    }
+
+    return report("rips-cohomology");
+}
@@ -0,0 +1,82 @@
+#include <map>
+
+#include <dionysus/fields/z2.h>
+#include <dionysus/fields/zp.h>
+#include <dionysus/standard-reduction.h>
+#include <dionysus/vineyard.h>
+
+#include "common.h"
+
+// after reorder(), the pairs match a reduction of the new filtration from scratch, and R = DV
+template<class Field>
+void check(const Field& field, const Filtration& before, const Filtration& after, bool clearing)
+{
+    typedef     d::Vineyard<Field>                      Vineyard;
+    typedef     typename Vineyard::Persistence          Persistence;
+    typedef     typename Vineyard::Index                Index;
+
+    Persistence                         persistence(field);
+    d::StandardReduction<Persistence>   reduce(persistence);
+    reduce.set_clearing(clearing);
+    reduce(before);
+
+    Vineyard vineyard(std::move(persistence), before);
+
+    // order[k] is the id (position in before) of the k-th cell of after
+    typename Vineyard::Indices order;
+    for (auto& c : after)
+        order.push_back(before.index(c, 0));
+    vineyard.reorder(order);
+
+    for (Index k = 0; k < order.size(); ++k)
+        CHECK(vineyard.cell(k) == order[k]);
+
+    Persistence                         expected(field);
+    d::StandardReduction<Persistence>   reduce_expected(expected);
+    reduce_expected(after);
+
+    for (Index k = 0; k < order.size(); ++k)
+    {
+        Index p = expected.pair(k);
+        CHECK(vineyard.pair(order[k]) == (p == expected.unpaired() ? vineyard.unpaired() : order[p]));
+    }
+
+    // R = DV, by cell ids
+    for (Index c = 0; c < before.size(); ++c)
+    {
+        std::map<Index, typename Field::Element> dv;
+        for (auto& x : vineyard.v(c))
+            for (auto&& y : before[x.index()].boundary(field))
+            {
+                auto& e = dv.emplace(before.index(y.index(), 0), field.zero()).first->second;
+                e = field.add(e, field.mul(x.element(), y.element()));
+            }
+
+        std::map<Index, typename Field::Element> r;
+        for (auto& x : vineyard[c])
+            r.emplace(x.index(), x.element());
+
+        for (auto& x : dv)
+            CHECK(field.is_zero(x.second) ? r.count(x.first) == 0 : (r.count(x.first) && r[x.first] == x.second));
+        for (auto& x : r)
+            CHECK(dv.count(x.first) && !field.is_zero(dv[x.first]));
+    }
+}
+
+int main()
+{
+    for (unsigned seed = 0; seed < 4; ++seed)
+    {
+        // the same flag complex, under two different sets of edge lengths
+        Filtration before = random_flag_filtration(8, 3, seed),
+                   after  = random_flag_filtration(8, 3, seed + 100);
+
+        for (bool clearing : { false, true })
+        {
+            check(d::Z2Field(), before, after, clearing);
+            check(d::ZpField<short>(3), before, after, clearing);
+        }
+    }
+
+    return report("vineyard");
+}
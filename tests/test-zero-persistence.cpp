@@ -0,0 +1,151 @@
+#include <tuple>
+#include <limits>
+
+#include <dionysus/fields/z2.h>
+#include <dionysus/ordinary-persistence.h>
+#include <dionysus/standard-reduction.h>
+#include <dionysus/zero-persistence.h>
+
+#include "common.h"
+
+typedef     d::OrdinaryPersistence<d::Z2Field>                  Persistence;
+typedef     Persistence::Index                                  Index;
+typedef     std::tuple<unsigned, unsigned, float>               Edge;
+typedef     std::vector<std::tuple<float, float, unsigned>>     Points;         // (birth, death, vertex)
+
+struct MatrixDistances
+{
+    typedef     unsigned    IndexType;
+    typedef     float       DistanceType;
+
+    DistanceType    operator()(IndexType u, IndexType v) const  { return distances[u][v]; }
+    IndexType       begin() const                               { return 0; }
+    IndexType       end() const                                 { return distances.size(); }
+    IndexType       size() const                                { return distances.size(); }
+
+    const Distances&    distances;
+};
+
+const float infinity = std::numeric_limits<float>::infinity();
+
+// vertices born at births, and the edges of the complete graph no longer than max (at the larger of
+// their length and their vertices' births); sorted by value, vertices before edges
+Filtration  graph_filtration(const std::vector<float>& births, const Distances& distances, float max)
+{
+    std::vector<Simplex> simplices;
+    for (unsigned v = 0; v < births.size(); ++v)
+        simplices.push_back(Simplex({v}, births[v]));
+    for (unsigned u = 0; u < births.size(); ++u)
+        for (unsigned v = u + 1; v < births.size(); ++v)
+            if (distances[u][v] <= max)
+                simplices.push_back(Simplex({u,v}, std::max(distances[u][v], std::max(births[u], births[v]))));
+
+    std::stable_sort(simplices.begin(), simplices.end(), [](const Simplex& s1, const Simplex& s2)
+                     { return s1.data() < s2.data() || (s1.data() == s2.data() && s1.dimension() < s2.dimension()); });
+    return Filtration(simplices.begin(), simplices.end());
+}
+
+std::vector<Edge>   edges(const Filtration& filtration)
+{
+    std::vector<Edge> result;
+    for (auto& s : filtration)
+        if (s.dimension() == 1)
+            result.emplace_back(s[0], s[1], s.data());
+    return result;
+}
+
+// the 0-dimensional points of the standard reduction, without those on the diagonal
+Points      expected_points(const Filtration& filtration)
+{
+    Persistence                         persistence(d::Z2Field{});
+    d::StandardReduction<Persistence>   reduce(persistence);
+    reduce(filtration);
+
+    Points result;
+    for (Index i = 0; i < filtration.size(); ++i)
+    {
+        const auto& s = filtration[i];
+        if (s.dimension() != 0)
+            continue;
+        Index j = persistence.pair(i);
+        if (j == persistence.unpaired())
+            result.emplace_back(s.data(), infinity, s[0]);
+        else if (s.data() != filtration[j].data())
+            result.emplace_back(s.data(), filtration[j].data(), s[0]);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+template<class Diagram>
+Points      points(const Diagram& diagram)
+{
+    Points result;
+    for (auto& p : diagram)
+        result.emplace_back(p.birth(), p.death(), p.data);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// ZeroPersistence pairs the vertices and the edges like the standard reduction, and skips the rest
+void check_pairs(const Filtration& filtration)
+{
+    Persistence                         expected(d::Z2Field{});
+    d::StandardReduction<Persistence>   reduce(expected);
+    reduce(filtration);
+
+    d::ZeroPersistence<Index>   zero;
+    size_t                      reported = 0;
+    zero(filtration, [&reported](int d, Index, Index) { CHECK(d == 0); ++reported; });
+
+    size_t negative_edges = 0;
+    CHECK(zero.size() == filtration.size());
+    for (Index i = 0; i < filtration.size(); ++i)
+    {
+        unsigned dim = filtration[i].dimension();
+        if (dim == 0)
+            CHECK(zero.pair(i) == expected.pair(i) && !zero.skip(i));
+        else if (dim == 1 && expected.pair(i) < i)
+        {
+            CHECK(zero.pair(i) == expected.pair(i) && !zero.skip(i));
+            ++negative_edges;
+        } else
+            CHECK(zero.pair(i) == zero.unpaired() && zero.skip(i));
+    }
+    CHECK(reported == negative_edges);
+}
+
+int main()
+{
+    for (unsigned seed = 0; seed < 5; ++seed)
+    {
+        Distances distances = random_distances(30, seed);
+
+        check_pairs(random_flag_filtration(15, 2, seed));
+
+        // zero_persistence(), with the vertices born at 0 and later, and a disconnected graph
+        std::mt19937                            gen(seed);
+        std::uniform_real_distribution<float>   birth(0, .5);
+        std::vector<float> zeros(distances.size(), 0), births;
+        for (unsigned v = 0; v < distances.size(); ++v)
+            births.push_back(birth(gen));
+
+        for (float max : { .03f, .1f, 1.f })
+            for (auto& b : { zeros, births })
+            {
+                Filtration filtration = graph_filtration(b, distances, max);
+                check_pairs(filtration);
+                CHECK(points(d::zero_persistence(b, edges(filtration))) == expected_points(filtration));
+            }
+
+        // rips_zero_persistence(), with and without a maximum scale
+        MatrixDistances matrix { distances };
+        CHECK(points(d::rips_zero_persistence(matrix)) == expected_points(graph_filtration(zeros, distances, infinity)));
+        Points disconnected = expected_points(graph_filtration(zeros, distances, .03f));
+        CHECK(std::count_if(disconnected.begin(), disconnected.end(),
+                            [](const std::tuple<float,float,unsigned>& p) { return std::get<1>(p) == infinity; }) > 1);
+        CHECK(points(d::rips_zero_persistence(matrix, .03f)) == disconnected);
+    }
+
+    return report("zero-persistence");
+}
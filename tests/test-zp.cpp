@@ -0,0 +1,199 @@
+#include <cstdint>
+#include <limits>
+
+#include <dionysus/fields/zp.h>
+#include <dionysus/ordinary-persistence.h>
+#include <dionysus/standard-reduction.h>
+
+#include "common.h"
+
+const std::vector<uint64_t> primes { 2, 3, 5, 11, 251, 32003, 65521, 2147483647 };
+
+// Barrett reduction agrees with %, including around multiples of p and at the extremes
+template<class Wide>
+void check_barrett(std::mt19937_64& gen)
+{
+    for (uint64_t p64 : primes)
+    {
+        Wide p = p64;
+        if (p != p64)
+            continue;
+        Wide m = std::numeric_limits<Wide>::max() / p;
+
+        std::vector<Wide> xs { 0, 1, p - 1, p, p + 1, 2*p - 1, 2*p, std::numeric_limits<Wide>::max(),
+                               std::numeric_limits<Wide>::max() - p, std::numeric_limits<Wide>::max() / p * p };
+        for (unsigned i = 0; i < 10000; ++i)
+            xs.push_back(Wide(gen()));
+        for (Wide x : xs)
+            CHECK(d::detail::barrett_reduce(x, p, m) == x % p);
+    }
+}
+
+// ZpField's arithmetic agrees with the naive one
+template<class Element>
+void check_arithmetic(std::mt19937_64& gen)
+{
+    for (uint64_t p : primes)
+    {
+        if (p > uint64_t(std::numeric_limits<Element>::max()) || p > (1u << 20))        // the table of inverses is O(p)
+            continue;
+        d::ZpField<Element> field(p);
+
+        std::uniform_int_distribution<uint64_t> element(0, p - 1);
+        for (unsigned i = 0; i < 1000; ++i)
+        {
+            uint64_t x = element(gen), a = element(gen), y = element(gen);
+            CHECK(uint64_t(field.add(x, y))       == (x + y) % p);
+            CHECK(uint64_t(field.mul(a, y))       == a * y % p);
+            CHECK(uint64_t(field.muladd(x, a, y)) == (x + a * y) % p);
+            CHECK(y == 0 || uint64_t(field.mul(y, field.inv(y))) == 1);
+
+            // any representative gives the same results
+            Element xs = Element(x) - Element(p), as = Element(a) - Element(p), ys = Element(y) - Element(p);
+            CHECK(field.add(xs, ys)       == field.add(x, y));
+            CHECK(field.mul(as, ys)       == field.mul(a, y));
+            CHECK(field.muladd(xs, as, ys) == field.muladd(x, a, y));
+            CHECK(field.neg(ys)           == field.neg(y));
+            CHECK(field.lazy_mul(as, ys)  == field.lazy_mul(a, y));
+        }
+    }
+}
+
+// Columns keep the representatives they are set with (e.g., -1, like the Python bindings'
+// boundary()); the reduction accepts them and gives the same pairs
+void check_signed_columns(short p, const Filtration& filtration)
+{
+    typedef     d::ZpField<short>                           Zp;
+    typedef     d::OrdinaryPersistence<Zp>                  Persistence;
+    typedef     Persistence::Index                          Index;
+
+    Zp field(p);
+
+    Persistence                         expected(field);
+    d::StandardReduction<Persistence>   reduce(expected);
+    reduce(filtration);
+
+    for (bool heap : { false, true })
+    {
+        Persistence signed_columns(field);
+        signed_columns.set_heap_column(heap);
+        signed_columns.resize(filtration.size());
+        for (Index i = 0; i < filtration.size(); ++i)
+        {
+            Persistence::Chain chain;
+            for (auto&& x : filtration[i].boundary(field))
+            {
+                short e = x.element();
+                chain.emplace_back(e > p / 2 ? e - p : e, filtration.index(x.index(), i));
+            }
+            signed_columns.set(i, std::move(chain));
+        }
+
+        bool negative = false;
+        for (Index i = 0; i < filtration.size(); ++i)
+            for (auto& e : signed_columns[i])
+                negative |= e.element() < 0;
+        CHECK(p == 2 || negative);
+
+        signed_columns.reduce_upto(filtration.size());
+        CHECK(pairs(signed_columns) == pairs(expected));
+    }
+}
+
+// The lazy arithmetic of Z/pZ, for a prime too large for ZpField's table of inverses
+struct LargeZp
+{
+    typedef     uint64_t        Element;
+    typedef     uint64_t        Accumulator;
+
+    Element     reduce(Accumulator x) const                 { return x % p; }
+    Accumulator lazy_mul(Element a, Element y) const        { return a * y; }
+    Accumulator lazy_bound() const                          { return ~Accumulator(0) / ((p - 1) * (p - 1)); }
+    bool        is_zero(Element a) const                    { return a == 0; }
+
+    uint64_t    p;
+};
+
+// Many large products at one index overflow unless the column reduces every lazy_bound() terms
+void check_lazy_bound()
+{
+    typedef     d::ChainEntry<d::ZpField<long>, unsigned>                   Entry;
+    typedef     std::vector<Entry>                                          Chain;
+    typedef     d::LazyHeapColumn<LargeZp, unsigned, std::less<unsigned>>   Column;
+
+    uint64_t            p = 2147483647;
+    LargeZp             field { p };
+    std::less<unsigned> cmp;
+    CHECK(field.lazy_bound() == 4);
+    CHECK(d::ZpField<short>(3).lazy_bound() == ~uint32_t(0) / 4);
+    CHECK(d::ZpField<short>(32003).lazy_bound() == 4);
+
+    Column::Entries entries;
+    Column          column(entries, field, cmp);
+    Chain c { Entry(p - 1, 5) };
+    column.assign(c);
+
+    Chain y { Entry(p - 2, 5), Entry(p - 1, 7) };          // add_all_but_low() skips 7
+    uint64_t expected = p - 1;
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        column.add_all_but_low(p - 3, y);
+        expected = (expected + (p - 3) * (p - 2)) % p;
+    }
+
+    column.finalize(c);
+    CHECK(c.size() == 1 && c[0].index() == 5 && uint64_t(c[0].element()) == expected);
+}
+
+// With the heap column, the reduction over Zp is lazy; it gives the same R and pairs
+template<class Element>
+void check_lazy_reduction(Element p, const Filtration& filtration)
+{
+    typedef     d::ZpField<Element>                         Zp;
+    typedef     d::OrdinaryPersistence<Zp>                  Persistence;
+
+    Persistence                         merged(Zp{p});
+    d::StandardReduction<Persistence>   reduce_merged(merged);
+    reduce_merged(filtration);
+
+    Persistence                         lazy(Zp{p});
+    lazy.set_heap_column();
+    d::StandardReduction<Persistence>   reduce_lazy(lazy);
+    reduce_lazy(filtration);
+
+    CHECK(pairs(lazy) == pairs(merged));
+    for (size_t i = 0; i < filtration.size(); ++i)
+    {
+        CHECK(lazy[i].size() == merged[i].size());
+        for (size_t k = 0; k < std::min(lazy[i].size(), merged[i].size()); ++k)
+            CHECK(lazy[i][k].index() == merged[i][k].index() && lazy[i][k].element() == merged[i][k].element());
+    }
+}
+
+int main()
+{
+    std::mt19937_64 gen(0);
+    check_barrett<uint32_t>(gen);
+    check_barrett<uint64_t>(gen);
+
+    check_arithmetic<short>(gen);
+    check_arithmetic<int>(gen);
+    check_arithmetic<long>(gen);
+
+    check_lazy_bound();
+
+    for (short p : { 2, 3, 5 })
+        check_signed_columns(p, random_flag_filtration(10, 3, 1));
+
+    for (unsigned seed = 0; seed < 3; ++seed)
+    {
+        Filtration filtration = random_flag_filtration(12, 3, seed);
+        for (short p : { 2, 3, 11, 32003 })
+            check_lazy_reduction<short>(p, filtration);
+        check_lazy_reduction<long>(1000003, filtration);
+    }
+    check_lazy_reduction<short>(2, projective_plane());
+    check_lazy_reduction<short>(3, projective_plane());
+
+    return report("zp");
+}
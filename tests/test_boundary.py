@@ -0,0 +1,40 @@
+import dionysus as d
+
+def points(dgms):
+    return sorted((dim, p.birth, p.death) for dim, dgm in enumerate(dgms) for p in dgm)
+
+def elements(chain):
+    return [e.element for e in chain]
+
+def triangle():
+    f = d.Filtration()
+    for vertices, time in [([0], 0), ([1], 1), ([2], 2), ([0,1], 3), ([0,2], 4), ([1,2], 5), ([0,1,2], 6)]:
+        f.append(d.Simplex(vertices, time))
+    return f
+
+def test_boundary_coefficients():
+    f = triangle()
+
+    # boundary() and coboundary() store the signed coefficients, +1 and -1
+    b = d.boundary(f)
+    assert [elements(b[i].boundary()) for i in range(len(b))] == \
+           [[], [], [], [-1, 1], [-1, 1], [-1, 1], [1, -1, 1]]
+
+    c = d.coboundary(f)                 # cells in reverse order
+    assert [elements(c[i].boundary()) for i in range(len(c))] == \
+           [[], [1], [-1], [1], [1, 1], [-1, 1], [-1, -1]]
+
+    # and reduce like the filtration itself
+    for prime in [2, 3, 5]:
+        assert points(d.init_diagrams(d.homology_persistence(b, prime=prime), b)) == \
+               points(d.init_diagrams(d.homology_persistence(f, prime=prime), f))
+
+def test_reduced_matrix_coefficients():
+    m = d.ReducedMatrix(d.Zp(3), 3)
+    m[2] = [(-1, 0), (1, 1)]
+    assert [(e.element, e.index) for e in m[2]] == [(-1, 0), (1, 1)]
+
+    # the arithmetic takes any representative
+    m.reduce_upto(3)
+    assert m.pair(1) == 2
+    assert m.homologous(d.Chain([(1, 1)]), d.Chain([(-2, 0)]))
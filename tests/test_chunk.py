@@ -0,0 +1,17 @@
+import numpy as np
+import dionysus as d
+
+def points(dgms):
+    return sorted((dim, p.birth, p.death) for dim, dgm in enumerate(dgms) for p in dgm)
+
+def test_chunk():
+    np.random.seed(0)
+    f = d.fill_rips(np.random.random((30, 3)), 3, 1.)
+
+    for prime in [2, 3]:
+        m = d.homology_persistence(f, prime=prime, method="column")
+        expected = [m.pair(i) for i in range(len(f))]
+
+        c = d.homology_persistence(f, prime=prime, method="chunk")
+        assert [c.pair(i) for i in range(len(f))] == expected
+        assert points(d.init_diagrams(c, f)) == points(d.init_diagrams(m, f))
@@ -0,0 +1,46 @@
+import pickle
+import numpy as np
+import pytest
+import dionysus as d
+
+def points(dgms):
+    return sorted((dim, p.birth, p.death) for dim, dgm in enumerate(dgms) for p in dgm)
+
+def test_pipeline():
+    np.random.seed(0)
+    f = d.fill_rips(np.random.random((30, 3)), 3, 1.)
+
+    for prime in [2, 3]:
+        expected = points(d.init_diagrams(d.homology_persistence(f, prime=prime, method="clearing"), f))
+        assert points(d.init_diagrams(d.homology_persistence(f, prime=prime, method="column"), f)) == expected
+
+        m = d.homology_persistence(f, prime=prime, method="pipeline")
+        assert points(d.init_diagrams(m, f)) == expected
+        for i in range(len(f)):
+            assert m.pair(i) == m.unpaired or m.pair(m.pair(i)) == i
+
+        expected = points(d.init_diagrams(d.homology_persistence(f, prime=prime, method="clearing", max_dim=1), f))
+        assert points(d.init_diagrams(d.homology_persistence(f, prime=prime, method="pipeline", max_dim=1), f)) == expected
+
+def test_pairs_only():
+    np.random.seed(0)
+    f = d.fill_rips(np.random.random((10, 2)), 2, 1.)
+
+    assert not d.homology_persistence(f, method="clearing").pairs_only
+
+    # the columns of the pipeline and union-find matrices are empty: reading them raises
+    for m in [d.homology_persistence(f, method="pipeline"), d.homology_persistence(f, method="clearing", max_dim=0)]:
+        assert m.pairs_only
+        with pytest.raises(RuntimeError):
+            m[len(f) - 1]
+        with pytest.raises(RuntimeError):
+            list(m)
+        with pytest.raises(RuntimeError):
+            m.homologous(d.Chain([(1, 0)]), d.Chain([(1, 1)]))
+        with pytest.raises(RuntimeError):
+            m.reduce_upto(len(f))
+
+        # the pairs are there, and survive pickling
+        m2 = pickle.loads(pickle.dumps(m))
+        assert m2.pairs_only
+        assert [m2.pair(i) for i in range(len(f))] == [m.pair(i) for i in range(len(f))]
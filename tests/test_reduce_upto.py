@@ -0,0 +1,51 @@
+import numpy as np
+import dionysus as d
+
+def points(dgms):
+    return sorted((dim, p.birth, p.death) for dim, dgm in enumerate(dgms) for p in dgm)
+
+def test_reduce_upto():
+    np.random.seed(0)
+    f = d.fill_rips(np.random.random((20, 2)), 2, 1.)
+    n = len(f)
+
+    for prime in [2, 3]:
+        expected = d.init_diagrams(d.homology_persistence(f, prime=prime, method="column"), f)
+
+        m = d.boundary_matrix(f, prime=prime)
+        assert m.reduced == 0
+
+        # the diagrams of the prefix are those of its own filtration
+        half = n // 2
+        assert m.reduce_upto(half) == half
+        assert m.reduced == half
+        prefix = d.Filtration([f[i] for i in range(half)])
+        assert points(d.init_diagrams(m, f, half)) == \
+               points(d.init_diagrams(d.homology_persistence(prefix, prime=prime, method="column"), prefix))
+
+        # resuming finishes the reduction
+        assert m.reduce_upto(n) == n
+        assert m.reduced == n
+        assert points(d.init_diagrams(m, f)) == points(expected)
+
+def test_reduce_upto_value():
+    np.random.seed(1)
+    f = d.fill_rips(np.random.random((20, 2)), 2, 1.)
+    f.sort()
+    values = sorted(set(s.data for s in f))
+
+    for prime in [2, 3]:
+        expected = d.init_diagrams(d.homology_persistence(f, prime=prime, method="column"), f)
+
+        # up to and including the value, ties included
+        m = d.boundary_matrix(f, prime=prime)
+        x = values[len(values) // 2]
+        n = sum(1 for s in f if s.data <= x)
+        assert m.reduce_upto(f, x) == n
+        assert m.reduced == n
+        prefix = d.Filtration([f[i] for i in range(n)])
+        assert points(d.init_diagrams(m, f, n)) == \
+               points(d.init_diagrams(d.homology_persistence(prefix, prime=prime, method="column"), prefix))
+
+        assert m.reduce_upto(f, values[-1]) == len(f)
+        assert points(d.init_diagrams(m, f)) == points(expected)
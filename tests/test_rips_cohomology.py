@@ -0,0 +1,21 @@
+import numpy as np
+import pytest
+import dionysus as d
+
+def points(dgms):
+    return sorted((dim, p.birth, p.death) for dim, dgm in enumerate(dgms) for p in dgm)
+
+def flatten(pts):
+    return [x for pt in pts for x in pt]
+
+def test_rips_cohomology():
+    np.random.seed(0)
+    pts = np.random.random((25, 2))
+
+    for k, r in [(1, .5), (2, .5), (2, 2.)]:
+        f = d.fill_rips(pts, k, r)
+        for prime in [2, 3]:
+            expected = points(d.init_diagrams(d.cohomology_persistence(f, prime), f))
+            result   = points(d.rips_cohomology(pts, k, r, prime))
+            assert len(result) == len(expected)
+            assert flatten(result) == pytest.approx(flatten(expected))
@@ -0,0 +1,29 @@
+import numpy as np
+import pytest
+import dionysus as d
+
+def points(dgm):
+    return sorted((p.birth, p.death) for p in dgm)
+
+def test_max_dim_zero():
+    np.random.seed(0)
+    f = d.fill_rips(np.random.random((40, 2)), 2, .3)      # disconnected at this radius
+
+    expected = d.init_diagrams(d.homology_persistence(f, method="column"), f)
+    assert sum(p.death == float('inf') for p in expected[0]) > 1
+
+    for method in ["clearing", "pipeline", "column", "column_no_negative"]:     # max_dim=0 uses union-find
+        m = d.homology_persistence(f, method=method, max_dim=0)
+        dgms = d.init_diagrams(m, f)
+        assert points(dgms[0]) == points(expected[0])
+        assert all(len(dgm) == 0 for dgm in dgms[1:])
+
+    # matrix_v needs V, so it reduces
+    r, v = d.homology_persistence(f, method="matrix_v", max_dim=0)
+    assert points(d.init_diagrams(r, f)[0]) == points(expected[0])
+
+def test_max_dim_zero_method():
+    f = d.fill_rips(np.random.random((10, 2)), 1, .5)
+    for method in ["nonsense", "chunk", "row"]:         # checked before the union-find shortcut
+        with pytest.raises(RuntimeError):
+            d.homology_persistence(f, method=method, max_dim=0)
@@ -0,0 +1,31 @@
+import itertools
+import numpy as np
+import dionysus as d
+
+def points(dgms):
+    return sorted((dim, p.birth, p.death, p.data) for dim, dgm in enumerate(dgms) for p in dgm)
+
+def test_zigzag_batch():
+    np.random.seed(0)
+    n = 8
+    simplices = [list(s) for k in [1, 2, 3] for s in itertools.combinations(range(n), k)]
+
+    # every vertex enters, leaves, and enters and leaves again; a simplex is present when all its vertices are,
+    # and many steps share a time, so they form batches
+    vertex_times = [(np.random.randint(0, 3), np.random.randint(3, 6), np.random.randint(6, 8), np.random.randint(8, 10))
+                    for v in range(n)]
+    times = [[float(t) for t in (max(vertex_times[v][0] for v in s), min(vertex_times[v][1] for v in s),
+                                     max(vertex_times[v][2] for v in s), min(vertex_times[v][3] for v in s))] for s in simplices]
+
+    f = d.Filtration(simplices)
+    for prime in [2, 3]:
+        zz, dgms, cells = d.zigzag_homology_persistence(f, times, prime=prime)
+
+        # with a callback, the steps are taken one at a time
+        steps = []
+        zz1, dgms1, cells1 = d.zigzag_homology_persistence(f, times, prime=prime,
+                                                           callback=lambda i, t, dir, zz, cells: steps.append(i))
+        assert len(steps) == sum(len(t) for t in times)
+
+        assert points(dgms) == points(dgms1)
+        assert len(cells) == len(cells1) == 0